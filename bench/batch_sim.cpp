@@ -0,0 +1,162 @@
+// Runs many independent Starfall sessions at once, for balancing and bot
+// experiments. Each session is a Simulation driven by a simple dodging bot;
+// sessions are handed out to a pool of worker threads one at a time.
+//
+// Build:  g++ -O2 -std=c++17 -I. -DSTARFALL_BUILD_HASH=0x$(git rev-parse --short=8 HEAD) bench/batch_sim.cpp src/*.cpp -lpthread -o batch_sim
+// Run:    ./batch_sim [--sessions N] [--threads N] [--seed N] [--max-ticks N]
+//
+// Session i is seeded with seed + i and results are gathered by index, so
+// the statistics are the same whatever the thread count.
+
+// The engine is only linked for the entity Draw() functions, never started
+#define OLC_PGE_HEADLESS
+#define OLC_PGE_APPLICATION
+#include "olcPixelGameEngine.h"
+
+#include "src/simulation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+struct SessionResult {
+	LevelResult outcome = LevelResult::PLAYING; // PLAYING means it hit the tick limit
+	int level = 0;
+	int score = 0;
+	uint32_t ticks = 0;
+};
+
+// Steers away from whatever is about to land on the ship, otherwise lines
+// up under the nearest enemy (or the boss) so auto-fire does the rest.
+static InputState BotInput(const Simulation& sim) {
+	const Player& p = sim.player;
+	InputState in;
+
+	float dodge = 0.0f;
+	float nearestDy = 1e9f;
+	auto consider = [&](const CircleArray& v) {
+		for (size_t i = 0; i < v.Size(); i++) {
+			if (!v.alive[i]) continue;
+			float dy = p.pos.y - v.y[i];
+			float dx = p.pos.x - v.x[i];
+			if (dy < 0.0f || dy > 180.0f || std::fabs(dx) > v.r[i] + p.r + 12.0f) continue;
+			if (dy < nearestDy) {
+				nearestDy = dy;
+				dodge = dx >= 0.0f ? 1.0f : -1.0f;
+			}
+		}
+	};
+	consider(sim.asteroids);
+	consider(sim.enemyBullets);
+
+	float targetX = p.pos.x;
+	if (dodge != 0.0f) {
+		// Running into a wall is no dodge, go the other way
+		if (dodge < 0.0f && p.pos.x - p.r < 40.0f) dodge = 1.0f;
+		if (dodge > 0.0f && p.pos.x + p.r > sim.width - 40.0f) dodge = -1.0f;
+		targetX = p.pos.x + dodge * 100.0f;
+	}
+	else if (sim.currentLevel == 3 && sim.boss.alive) {
+		targetX = sim.boss.pos.x;
+	}
+	else {
+		float best = 1e9f;
+		for (size_t i = 0; i < sim.enemies.Size(); i++) {
+			if (!sim.enemies.alive[i]) continue;
+			float d = std::fabs(sim.enemies.x[i] - p.pos.x);
+			if (d < best) { best = d; targetX = sim.enemies.x[i]; }
+		}
+	}
+
+	if (targetX < p.pos.x - 6.0f) in.bits |= InputBit::LEFT;
+	if (targetX > p.pos.x + 6.0f) in.bits |= InputBit::RIGHT;
+	if (p.pos.y < sim.height - 80.0f) in.bits |= InputBit::DOWN;
+	return in;
+}
+
+static SessionResult RunSession(uint32_t seed, uint32_t maxTicks, float dt) {
+	Simulation sim;
+	sim.Init(900, 600, seed);
+	sim.ResetGame();
+	sim.StartLevel(1);
+
+	SessionResult result;
+	for (result.ticks = 0; result.ticks < maxTicks; result.ticks++) {
+		LevelResult r = sim.Tick(dt, BotInput(sim));
+		sim.events.clear();
+
+		if (r == LevelResult::CLEARED) {
+			sim.StartLevel(sim.currentLevel + 1);
+		}
+		else if (r != LevelResult::PLAYING) {
+			result.outcome = r;
+			result.ticks++;
+			break;
+		}
+	}
+
+	result.level = sim.currentLevel;
+	result.score = sim.score;
+	return result;
+}
+
+int main(int argc, char** argv) {
+	uint32_t sessions = 1000;
+	uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+	uint32_t seed = 1;
+	uint32_t maxTicks = 120 * 60 * 5; // five minutes of play at 120 Hz
+	const float dt = 1.0f / 120.0f;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		uint32_t v = uint32_t(std::strtoul(argv[i + 1], nullptr, 10));
+		if (std::strcmp(argv[i], "--sessions") == 0) sessions = v;
+		else if (std::strcmp(argv[i], "--threads") == 0) threads = std::max(1u, v);
+		else if (std::strcmp(argv[i], "--seed") == 0) seed = v;
+		else if (std::strcmp(argv[i], "--max-ticks") == 0) maxTicks = v;
+	}
+
+	std::vector<SessionResult> results(sessions);
+	std::atomic<uint32_t> next{ 0 };
+
+	auto start = std::chrono::steady_clock::now();
+
+	// Sessions vary a lot in length, so workers pull the next index as they
+	// finish rather than taking fixed slices
+	std::vector<std::thread> pool;
+	for (uint32_t t = 0; t < threads; t++) {
+		pool.emplace_back([&]() {
+			for (uint32_t i = next++; i < sessions; i = next++)
+				results[i] = RunSession(seed + i, maxTicks, dt);
+		});
+	}
+	for (std::thread& t : pool) t.join();
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	uint32_t won = 0, lost = 0, timedOut = 0;
+	uint32_t reached[4] = {};
+	uint64_t totalTicks = 0, totalScore = 0;
+	for (const SessionResult& r : results) {
+		if (r.outcome == LevelResult::WON) won++;
+		else if (r.outcome == LevelResult::LOST) lost++;
+		else timedOut++;
+		reached[std::clamp(r.level, 0, 3)]++;
+		totalTicks += r.ticks;
+		totalScore += uint64_t(r.score);
+	}
+
+	std::printf("%u sessions on %u threads in %.3f s: %.1f sessions/sec, %.0f ticks/sec\n",
+		sessions, threads, seconds, sessions / seconds, totalTicks / seconds);
+	std::printf("won %u (%.1f%%), lost %u (%.1f%%), timed out %u\n",
+		won, 100.0 * won / std::max(1u, sessions), lost, 100.0 * lost / std::max(1u, sessions), timedOut);
+	std::printf("ended on level 1: %u, level 2: %u, level 3: %u\n", reached[1], reached[2], reached[3]);
+	std::printf("mean score %.1f, mean length %.1f s\n",
+		double(totalScore) / std::max(1u, sessions), totalTicks * dt / std::max(1u, sessions));
+	return 0;
+}
@@ -0,0 +1,210 @@
+// Offline asset bundler: decodes every PNG and WAV under assets/ once and
+// writes them into one file (src/asset_bundle.h) that the game maps at
+// startup, so a launch does no image or sound decoding at all.
+//
+// Build:  g++ -O2 -std=c++17 -I. bench/bundle_assets.cpp src/asset_bundle.cpp -lpng -lpthread -o bundle_assets
+// Run:    ./bundle_assets [--assets dir] [--out file] [--max-size N] [--max-seconds S]
+//         (from the repo root; the game looks for assets.bundle there)
+//
+// Images are stored as RGBA pixels, sounds as float frames at 44100Hz, the
+// rate the game's mixer runs at. --max-size shrinks any image whose longest
+// side is over N pixels (box filter) to trade detail for memory. WAVs longer
+// than --max-seconds (default 10) are left out, since the game streams long
+// music from disk. Entries are named by path, e.g. assets/sprites/bullet.png,
+// which is what the game passes to its loaders. Each entry also records
+// its source file's size and modification time, and the game skips an
+// entry whose file no longer matches, so edit an asset and it shows up
+// without rebuilding the bundle (rebuild to get the fast path back).
+
+#define OLC_PGE_HEADLESS
+#define OLC_IMAGE_LIBPNG
+#define OLC_PGE_APPLICATION
+#include "olcPixelGameEngine.h"
+
+#define USE_NOAUDIO
+#define OLC_PGEX_SOUND
+#include "olcPGEX_Sound.h"
+
+#include "src/asset_bundle.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct Blob {
+	AssetBundle::Entry entry{};
+	std::string name;
+	std::vector<uint8_t> data;
+};
+
+// Averages every source pixel the destination pixel covers
+static olc::Sprite Shrink(const olc::Sprite& src, int maxSize) {
+	float factor = float(maxSize) / float(std::max(src.width, src.height));
+	int w = std::max(1, int(src.width * factor));
+	int h = std::max(1, int(src.height * factor));
+	olc::Sprite dst(w, h);
+
+	for (int y = 0; y < h; y++) {
+		int y0 = y * src.height / h, y1 = std::max(y0 + 1, (y + 1) * src.height / h);
+		for (int x = 0; x < w; x++) {
+			int x0 = x * src.width / w, x1 = std::max(x0 + 1, (x + 1) * src.width / w);
+			uint32_t sum[4] = {};
+			for (int sy = y0; sy < y1; sy++) {
+				for (int sx = x0; sx < x1; sx++) {
+					olc::Pixel p = src.pColData[size_t(sy) * src.width + sx];
+					sum[0] += p.r; sum[1] += p.g; sum[2] += p.b; sum[3] += p.a;
+				}
+			}
+			uint32_t n = uint32_t((y1 - y0) * (x1 - x0));
+			dst.pColData[size_t(y) * w + x] = olc::Pixel(uint8_t(sum[0] / n), uint8_t(sum[1] / n), uint8_t(sum[2] / n), uint8_t(sum[3] / n));
+		}
+	}
+	return dst;
+}
+
+static bool AddImage(const std::string& name, int maxSize, std::vector<Blob>& blobs) {
+	olc::Sprite sprite;
+	if (sprite.LoadFromFile(name) != olc::rcode::OK || sprite.width <= 0 || sprite.height <= 0)
+		return false;
+	if (maxSize > 0 && std::max(sprite.width, sprite.height) > maxSize)
+		sprite = Shrink(sprite, maxSize);
+
+	Blob b;
+	b.name = name;
+	AssetBundle::SourceStamp(name, b.entry.sourceSize, b.entry.sourceTime);
+	b.entry.kind = AssetBundle::IMAGE;
+	b.entry.width = uint32_t(sprite.width);
+	b.entry.height = uint32_t(sprite.height);
+	b.data.resize(sprite.pColData.size() * sizeof(olc::Pixel));
+	std::memcpy(b.data.data(), sprite.pColData.data(), b.data.size());
+	blobs.push_back(std::move(b));
+	return true;
+}
+
+static bool AddSound(const std::string& name, float maxSeconds, std::vector<Blob>& blobs) {
+	// Before InitialiseAudio samples come out resampled to 44100Hz
+	olc::SOUND::AudioSample sample;
+	if (sample.LoadFromFile(name) != olc::rcode::OK)
+		return false;
+	bool keep = sample.nSamples <= long(maxSeconds * 44100.0f);
+
+	if (keep) {
+		Blob b;
+		b.name = name;
+		AssetBundle::SourceStamp(name, b.entry.sourceSize, b.entry.sourceTime);
+		b.entry.kind = AssetBundle::SOUND;
+		b.entry.frames = uint32_t(sample.nSamples);
+		b.entry.channels = uint32_t(sample.nChannels);
+		b.entry.sampleRate = 44100;
+		b.data.resize(size_t(sample.nSamples) * sample.nChannels * sizeof(float));
+		std::memcpy(b.data.data(), sample.fSample, b.data.size());
+		blobs.push_back(std::move(b));
+	}
+	else {
+		std::printf("%-36s skipped, %.1f s is streamed\n", name.c_str(), sample.nSamples / 44100.0f);
+	}
+	delete[] sample.fSample;
+	return true;
+}
+
+static bool Write(const std::string& path, std::vector<Blob>& blobs) {
+	auto align = [](uint64_t n, uint64_t to) { return (n + to - 1) / to * to; };
+
+	// Blobs first, each 16-byte aligned, then the index and the names
+	uint64_t offset = align(sizeof(AssetBundle::Header), 16);
+	for (Blob& b : blobs) {
+		b.entry.offset = offset;
+		b.entry.bytes = b.data.size();
+		offset = align(offset + b.data.size(), 16);
+	}
+
+	AssetBundle::Header h{};
+	std::memcpy(h.magic, AssetBundle::fileMagic, sizeof(h.magic));
+	h.version = AssetBundle::version;
+	h.count = uint32_t(blobs.size());
+	h.indexOffset = offset;
+
+	uint32_t nameOffset = uint32_t(blobs.size() * sizeof(AssetBundle::Entry));
+	for (Blob& b : blobs) {
+		b.entry.nameOffset = nameOffset;
+		b.entry.nameLength = uint32_t(b.name.size());
+		nameOffset += b.entry.nameLength;
+	}
+
+	std::ofstream out(path, std::ios::binary);
+	if (!out) return false;
+
+	const char zeros[16] = {};
+	auto pad = [&](uint64_t to) { out.write(zeros, std::streamsize(to - uint64_t(out.tellp()))); };
+
+	out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+	for (const Blob& b : blobs) {
+		pad(b.entry.offset);
+		out.write(reinterpret_cast<const char*>(b.data.data()), std::streamsize(b.data.size()));
+	}
+	pad(h.indexOffset);
+	for (const Blob& b : blobs)
+		out.write(reinterpret_cast<const char*>(&b.entry), sizeof(b.entry));
+	for (const Blob& b : blobs)
+		out.write(b.name.data(), std::streamsize(b.name.size()));
+	return bool(out);
+}
+
+int main(int argc, char** argv) {
+	std::string assetDir = "assets";
+	std::string outPath = "assets.bundle";
+	int maxSize = 0;
+	float maxSeconds = 10.0f;
+
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--assets") == 0 && i + 1 < argc) assetDir = argv[++i];
+		else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) outPath = argv[++i];
+		else if (std::strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) maxSize = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--max-seconds") == 0 && i + 1 < argc) maxSeconds = float(std::atof(argv[++i]));
+	}
+
+	// Sets up the image loader
+	olc::PixelGameEngine pge;
+
+	std::vector<std::string> names;
+	std::error_code ec;
+	for (const auto& f : fs::recursive_directory_iterator(assetDir, ec)) {
+		if (f.is_regular_file()) names.push_back(f.path().generic_string());
+	}
+	if (ec) {
+		std::printf("could not read %s\n", assetDir.c_str());
+		return 1;
+	}
+	std::sort(names.begin(), names.end()); // same bundle from the same files
+
+	std::vector<Blob> blobs;
+	for (const std::string& name : names) {
+		std::string ext = fs::path(name).extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+
+		bool ok = true;
+		if (ext == ".png") ok = AddImage(name, maxSize, blobs);
+		else if (ext == ".wav") ok = AddSound(name, maxSeconds, blobs);
+		else continue;
+
+		// Left out; the game falls back to the file and fails the same way
+		if (!ok) std::printf("%-36s could not be decoded, left out\n", name.c_str());
+	}
+
+	if (!Write(outPath, blobs)) {
+		std::printf("could not write %s\n", outPath.c_str());
+		return 1;
+	}
+
+	uint64_t images = 0, sounds = 0;
+	for (const Blob& b : blobs) (b.entry.kind == AssetBundle::IMAGE ? images : sounds) += b.data.size();
+	std::printf("wrote %zu assets to %s: %.1f MB of images, %.1f MB of sound\n", blobs.size(), outPath.c_str(),
+		images / 1048576.0, sounds / 1048576.0);
+	return 0;
+}
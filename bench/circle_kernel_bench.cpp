@@ -0,0 +1,83 @@
+// Scalar Dist2 loop vs the batched circle overlap kernel.
+//
+// Build:  g++ -O2 -std=c++17 -I. bench/circle_kernel_bench.cpp src/circle_kernel.cpp -o circle_kernel_bench
+// Run:    ./circle_kernel_bench
+//
+// Each query tests one circle against a packed field, the shape of work a
+// grid cell or a small brute-force pass hands to the kernel. Masks from both
+// paths are compared before timing.
+
+#include "src/circle_kernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+template<typename F>
+static double TimeNs(int reps, F&& f) {
+	auto t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < reps; i++) f();
+	auto t1 = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+}
+
+int main() {
+	std::mt19937 rng(99);
+	std::uniform_real_distribution<float> xDist(0.0f, 900.0f);
+	std::uniform_real_distribution<float> yDist(0.0f, 600.0f);
+	std::uniform_real_distribution<float> rDist(4.0f, 40.0f);
+
+	std::printf("kernel: %s\n", CircleKernelName());
+	std::printf("%8s %12s %12s %8s\n", "circles", "scalar ns", "kernel ns", "speedup");
+
+	// Sum the masks so neither loop can be optimised away
+	unsigned sink = 0;
+
+	const int queries = 256;
+	for (size_t n = 8; n <= 4096; n *= 2) {
+		std::vector<float> x(n), y(n), r(n);
+		for (size_t i = 0; i < n; i++) {
+			x[i] = xDist(rng);
+			y[i] = yDist(rng);
+			r[i] = rDist(rng);
+		}
+
+		std::vector<float> qx(queries), qy(queries), qr(queries);
+		for (int q = 0; q < queries; q++) {
+			qx[q] = xDist(rng);
+			qy[q] = yDist(rng);
+			qr[q] = rDist(rng);
+		}
+
+		std::vector<uint8_t> a((n + 7) / 8), b((n + 7) / 8);
+		for (int q = 0; q < queries; q++) {
+			CircleOverlapMasksScalar(qx[q], qy[q], qr[q], x.data(), y.data(), r.data(), n, a.data());
+			CircleOverlapMasks(qx[q], qy[q], qr[q], x.data(), y.data(), r.data(), n, b.data());
+			if (a != b) {
+				std::printf("MISMATCH at %zu circles\n", n);
+				return 1;
+			}
+		}
+
+		int reps = int(std::max<size_t>(8, 400000 / n));
+		double tScalar = TimeNs(reps, [&] {
+			for (int q = 0; q < queries; q++) {
+				CircleOverlapMasksScalar(qx[q], qy[q], qr[q], x.data(), y.data(), r.data(), n, a.data());
+				sink += a[0];
+			}
+		}) / queries;
+		double tKernel = TimeNs(reps, [&] {
+			for (int q = 0; q < queries; q++) {
+				CircleOverlapMasks(qx[q], qy[q], qr[q], x.data(), y.data(), r.data(), n, b.data());
+				sink += b[0];
+			}
+		}) / queries;
+
+		std::printf("%8zu %12.1f %12.1f %7.2fx\n", n, tScalar, tKernel, tScalar / tKernel);
+	}
+
+	std::printf("checksum %u\n", sink);
+	return 0;
+}
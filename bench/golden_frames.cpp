@@ -0,0 +1,253 @@
+// Golden-frame check: plays fixed scenes headless with deterministic input,
+// renders chosen frames on the software rasterizer and compares them with
+// the reference PNGs in bench/golden/. Run it before landing renderer or
+// batching changes to catch anything that breaks the layered draw order.
+//
+// Build:  g++ -O2 -std=c++17 -I. -DSTARFALL_BUILD_HASH=0x$(git rev-parse --short=8 HEAD) bench/golden_frames.cpp src/*.cpp -lpng -lpthread -o golden_frames
+// Run:    ./golden_frames [--update] [--out dir] [--tolerance N] [--max-bad F]
+//         (from the repo root, so assets/ and bench/golden/ resolve)
+//
+// A pixel is bad when any channel is more than --tolerance (default 8) away
+// from the reference; a scene fails when more than --max-bad (default 0.1%)
+// of its pixels are bad. Failing scenes write <name>.png and <name>_diff.png
+// to --out (default golden_out) and the exit code is non-zero. --update
+// rewrites the references from the current build instead of comparing.
+
+#define OLC_PGE_HEADLESS
+#define OLC_IMAGE_LIBPNG
+#define OLC_PGE_APPLICATION
+#include "olcPixelGameEngine.h"
+
+#define USE_NOAUDIO
+#define OLC_PGEX_SOUND
+#include "olcPGEX_Sound.h"
+
+#include "src/space_shooter.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sys/stat.h>
+
+// How a scene begins. PLAY starts the level, INTRO the intro story. The
+// other three start the level with its end already met (time up or kills
+// reached, boss dead, no lives left), so after the end-of-level pause the
+// game goes through finishLevel into the story that follows.
+enum class Start { PLAY, INTRO, CLEAR, WIN, LOSE };
+
+// One captured frame: the scene played from its start for 'ticks' ticks of
+// the built-in input script. Story scenes press ENTER 'presses' times.
+struct Scene {
+    const char* name;
+    Start start;
+    int level;
+    uint32_t ticks;
+    int presses;
+};
+
+// First ENTER once a level's end is forced: its 2 s pause at 120 ticks/s,
+// then half a second into the story
+static constexpr uint32_t storyPress = 300;
+
+static const Scene scenes[] = {
+    { "story_intro",      Start::INTRO, 0,   90, 1 },
+    { "level1_asteroids", Start::PLAY,  1,  900, 0 },
+    { "level2_enemies",   Start::PLAY,  2, 1200, 0 },
+    { "level3_boss_hud",  Start::PLAY,  3,  900, 0 },
+    { "story_level2",     Start::CLEAR, 1,  360, 1 },
+    { "story_level3",     Start::CLEAR, 2,  360, 0 },
+    { "story_win",        Start::WIN,   3,  360, 1 },
+    { "story_lose",       Start::LOSE,  2,  360, 1 },
+    { "game_over",        Start::LOSE,  1,  400, 3 }, // past the last slide
+};
+// Most story slides are JPEG files named .png, which the libpng loader
+// turns away, so the ending scenes show the slide text without a picture.
+// story_level2 and story_level3 land on the real PNG slides.
+
+class GoldenFrames : public SpaceShooter
+{
+public:
+    bool update = false;
+    std::string goldenDir = "bench/golden";
+    std::string outDir = "golden_out";
+    int tolerance = 8;
+    double maxBad = 0.001;
+
+    int failures = 0;
+
+    size_t scene = 0;
+    uint32_t sceneTick = 0;
+
+    // Weaves across the screen like headless_bench. Story scenes sit still
+    // and press ENTER 20 ticks apart, so one press lands the capture on the
+    // second slide mid-pan.
+    void BuildScript(const Scene& s)
+    {
+        uint32_t firstPress = s.start == Start::INTRO ? 1 : storyPress;
+        recording.ticks.assign(s.ticks + 1, InputState());
+        for (uint32_t t = 0; t <= s.ticks; t++) {
+            uint16_t bits = 0;
+            if (s.start == Start::PLAY) {
+                bits = (t / 180) % 2 ? InputBit::RIGHT : InputBit::LEFT;
+                bits |= (t / 480) % 2 ? InputBit::DOWN : InputBit::UP;
+            }
+            else if (t >= firstPress && t < firstPress + 20 * uint32_t(s.presses) && (t - firstPress) % 20 == 0) {
+                bits = InputBit::PRESSED_ENTER;
+            }
+            recording.ticks[t].bits = bits;
+        }
+        replayTick = 0;
+    }
+
+    void EnterScene(const Scene& s)
+    {
+        BuildScript(s);
+        sceneTick = 0;
+        if (s.start == Start::INTRO) {
+            ResetGame();
+            return;
+        }
+
+        endStory();
+        startLevel(s.level);
+        state = GameState::LEVEL_PLAY;
+        switch (s.start) {
+        case Start::CLEAR:
+            if (s.level == 1) sim.levelTime = sim.level1Duration;
+            else sim.enemiesKilled = sim.level2KillTarget;
+            break;
+        case Start::WIN:
+            sim.boss.hp = 0;
+            sim.boss.alive = false;
+            sim.wins = true;
+            break;
+        case Start::LOSE:
+            sim.player.lives = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    static bool Similar(olc::Pixel a, olc::Pixel b, int tolerance)
+    {
+        return std::abs(a.r - b.r) <= tolerance && std::abs(a.g - b.g) <= tolerance &&
+            std::abs(a.b - b.b) <= tolerance && std::abs(a.a - b.a) <= tolerance;
+    }
+
+    void Check(const Scene& s, const olc::Sprite& frame)
+    {
+        olc::Sprite copy(frame.width, frame.height);
+        copy.pColData = frame.pColData;
+        std::string reference = goldenDir + "/" + s.name + ".png";
+
+        if (update) {
+            if (olc::Sprite::loader->SaveImageResource(&copy, reference) == olc::rcode::OK)
+                std::printf("%-18s wrote %s\n", s.name, reference.c_str());
+            else {
+                std::printf("%-18s could not write %s\n", s.name, reference.c_str());
+                failures++;
+            }
+            return;
+        }
+
+        olc::Sprite golden;
+        if (golden.LoadFromFile(reference) != olc::rcode::OK) {
+            std::printf("%-18s FAIL no reference %s (run with --update)\n", s.name, reference.c_str());
+            failures++;
+            return;
+        }
+        if (golden.width != frame.width || golden.height != frame.height) {
+            std::printf("%-18s FAIL size %dx%d, reference %dx%d\n", s.name,
+                frame.width, frame.height, golden.width, golden.height);
+            failures++;
+            return;
+        }
+
+        // Bad pixels are white in the diff image, good ones a dimmed copy
+        olc::Sprite diff(frame.width, frame.height);
+        size_t bad = 0;
+        int worst = 0;
+        for (size_t i = 0; i < frame.pColData.size(); i++) {
+            olc::Pixel a = frame.pColData[i], b = golden.pColData[i];
+            worst = std::max({ worst, std::abs(a.r - b.r), std::abs(a.g - b.g), std::abs(a.b - b.b), std::abs(a.a - b.a) });
+            if (Similar(a, b, tolerance)) {
+                diff.pColData[i] = olc::Pixel(a.r / 4, a.g / 4, a.b / 4);
+            }
+            else {
+                diff.pColData[i] = olc::WHITE;
+                bad++;
+            }
+        }
+
+        double fraction = double(bad) / double(frame.pColData.size());
+        bool pass = fraction <= maxBad;
+        std::printf("%-18s %s %zu bad pixels (%.3f%%), worst channel diff %d\n",
+            s.name, pass ? "ok  " : "FAIL", bad, fraction * 100.0, worst);
+        if (pass) return;
+
+        failures++;
+        mkdir(outDir.c_str(), 0755);
+        olc::Sprite::loader->SaveImageResource(&copy, outDir + "/" + s.name + ".png");
+        olc::Sprite::loader->SaveImageResource(&diff, outDir + "/" + s.name + "_diff.png");
+    }
+
+    bool OnUserCreate() override
+    {
+        if (!SpaceShooter::OnUserCreate()) return false;
+        EnterScene(scenes[0]);
+        return true;
+    }
+
+    bool OnUserUpdate(float dt) override
+    {
+        // The renderer presents after OnUserUpdate returns, so the frame
+        // drawn on the scene's last tick is only readable one call later
+        if (sceneTick == scenes[scene].ticks) {
+            auto* renderer = dynamic_cast<olc::Renderer_Headless*>(olc::renderer.get());
+            Check(scenes[scene], renderer->GetFrame());
+
+            if (++scene == std::size(scenes)) return false;
+            EnterScene(scenes[scene]);
+        }
+
+        sceneTick++;
+        return SpaceShooter::OnUserUpdate(dt);
+    }
+};
+
+int main(int argc, char** argv)
+{
+    GoldenFrames golden;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--update") == 0)
+            golden.update = true;
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            golden.outDir = argv[++i];
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+            golden.tolerance = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-bad") == 0 && i + 1 < argc)
+            golden.maxBad = std::atof(argv[++i]);
+    }
+
+    // Same seed every run; each level reseeds from it as it starts
+    golden.rngSeed = 1;
+    golden.deterministic = true;
+    golden.replaying = true;
+
+    if (golden.Construct(900, 600, 1, 1) != olc::OK)
+        return 1;
+    golden.Start();
+
+    if (golden.scene < std::size(scenes)) {
+        std::printf("stopped after %zu of %zu scenes\n", golden.scene, std::size(scenes));
+        return 1;
+    }
+    if (golden.failures > 0) {
+        std::printf("%d of %zu scenes failed\n", golden.failures, std::size(scenes));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Runs SpaceShooter with no window, GPU or sound card for a fixed number of
+// ticks, as fast as it will go, and reports ticks/sec plus where the time went.
+//
+// Build:  g++ -O2 -std=c++17 -I. -DSTARFALL_BUILD_HASH=0x$(git rev-parse --short=8 HEAD) bench/headless_bench.cpp src/*.cpp -lpng -lpthread -o headless_bench
+// Run:    ./headless_bench [--ticks N] [--level 1|2|3] [--seed N] [--replay file]
+//                          [--render] [--threads N] [--audio-out file.wav]
+//         (from the repo root, so assets/ resolves)
+//
+// Without --replay the player follows a built-in weaving script, and the
+// level restarts whenever it ends so every tick is gameplay. With --replay
+// the recorded keys drive the game from wherever the recording started
+// (the menu, unless --level is given) until they run out.
+//
+// Frames are only submitted by default. --render has the headless renderer
+// rasterise every frame as well, on --threads workers (0 for one per core),
+// so the difference between the two runs is the cost of software rendering.
+//
+// Sound is mixed on the offline backend as game time passes and shows up as
+// the audio_mix phase. --audio-out also writes the mix to a WAV; a given
+// script and seed always produce the same file.
+
+#define OLC_PGE_HEADLESS
+#define OLC_IMAGE_LIBPNG
+#define OLC_PGE_APPLICATION
+#include "olcPixelGameEngine.h"
+
+#define USE_NOAUDIO
+#define OLC_PGEX_SOUND
+#include "olcPGEX_Sound.h"
+
+#include "src/space_shooter.h"
+
+#include <chrono>
+#include <cstdio>
+
+class HeadlessBench : public SpaceShooter
+{
+public:
+    int level = 1;
+    bool jumpToLevel = true;
+    std::string audioOut;
+    bool scripted = true;
+    uint32_t restarts = 0;
+
+    std::chrono::steady_clock::time_point started;
+
+    // Sweeps left and right across the screen, drifting up and down slower,
+    // so the ship keeps meeting new asteroids and bullets
+    void BuildScript(uint32_t ticks)
+    {
+        uint32_t sweep = uint32_t(simTickRate * 1.5f);
+        uint32_t drift = uint32_t(simTickRate * 4.0f);
+
+        recording.ticks.resize(ticks);
+        for (uint32_t t = 0; t < ticks; t++) {
+            uint16_t bits = (t / sweep) % 2 ? InputBit::RIGHT : InputBit::LEFT;
+            bits |= (t / drift) % 2 ? InputBit::DOWN : InputBit::UP;
+            recording.ticks[t].bits = bits;
+        }
+    }
+
+    void EnterLevel()
+    {
+        startLevel(level);
+        state = GameState::LEVEL_PLAY;
+    }
+
+    bool OnUserCreate() override
+    {
+        if (!SpaceShooter::OnUserCreate()) return false;
+        if (jumpToLevel) EnterLevel();
+
+        sim.phases.enabled = true;
+        started = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool OnUserUpdate(float dt) override
+    {
+        bool running = SpaceShooter::OnUserUpdate(dt);
+
+        if (scripted && state != GameState::LEVEL_PLAY) {
+            EnterLevel();
+            restarts++;
+        }
+        return running;
+    }
+
+    void Report() const
+    {
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        uint64_t ticks = replayTick;
+
+        std::printf("%llu ticks in %.3f s: %.0f ticks/sec (%u level restarts)\n",
+            (unsigned long long)ticks, wall, ticks / wall, restarts);
+
+        double timed = 0.0;
+        for (int p = 0; p < PhaseTimer::COUNT; p++) timed += sim.phases.seconds[p];
+
+        std::printf("%-18s %12s %10s %7s\n", "phase", "total ms", "us/tick", "share");
+        for (int p = 0; p < PhaseTimer::COUNT; p++) {
+            std::printf("%-18s %12.2f %10.2f %6.1f%%\n", PhaseTimer::Name(p),
+                sim.phases.seconds[p] * 1e3, ticks ? sim.phases.seconds[p] * 1e6 / ticks : 0.0,
+                wall > 0.0 ? 100.0 * sim.phases.seconds[p] / wall : 0.0);
+        }
+        std::printf("%-18s %12.2f %10.2f %6.1f%%\n", "other",
+            (wall - timed) * 1e3, ticks ? (wall - timed) * 1e6 / ticks : 0.0,
+            wall > 0.0 ? 100.0 * (wall - timed) / wall : 0.0);
+
+        if (!audioOut.empty())
+            std::printf("wrote %.1f s of audio to %s\n", ticks / simTickRate, audioOut.c_str());
+    }
+};
+
+int main(int argc, char** argv)
+{
+    HeadlessBench bench;
+    uint32_t ticks = 20000;
+    bool levelGiven = false;
+    olc::Renderer_Headless::bRasterise = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+            ticks = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            bench.level = std::clamp(std::atoi(argv[++i]), 1, 3);
+            levelGiven = true;
+        }
+        else if (std::strcmp(argv[i], "--render") == 0)
+            olc::Renderer_Headless::bRasterise = true;
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            olc::Renderer_Headless::nThreads = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--audio-out") == 0 && i + 1 < argc)
+            bench.audioOut = argv[++i];
+    }
+    olc::SOUND::SetOutputFile(bench.audioOut);
+
+    // Fixed workload by default; --seed and --replay override it
+    bench.rngSeed = 1;
+    bench.deterministic = true;
+    if (!bench.ParseCommandLine(argc, argv))
+        return 1;
+
+    if (bench.replaying) {
+        bench.scripted = false;
+        bench.jumpToLevel = levelGiven;
+        if (bench.recording.ticks.size() > ticks) bench.recording.ticks.resize(ticks);
+    }
+    else {
+        bench.BuildScript(ticks);
+        bench.replaying = true;
+    }
+
+    if (bench.Construct(900, 600, 1, 1) != olc::OK)
+        return 1;
+    bench.Start();
+    bench.Report();
+    return 0;
+}
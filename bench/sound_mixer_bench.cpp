@@ -0,0 +1,124 @@
+// Per-sample mixing (what GetMixerOutput used to do) vs SOUND::MixBlock,
+// with 64 looping voices of the game's own effects.
+//
+// Build:  g++ -O2 -std=c++17 -I. bench/sound_mixer_bench.cpp -lpthread -o sound_mixer_bench
+// Run:    ./sound_mixer_bench
+//         (from the repo root, so assets/ resolves)
+//
+// No sound card is used: the silent backend sets the mixer up and the bench
+// drives MixBlock itself. Both paths read every voice from the start of its
+// sample, so the first blocks are compared sample for sample before timing.
+
+#define OLC_PGE_HEADLESS
+#define OLC_PGE_APPLICATION
+#include "olcPixelGameEngine.h"
+
+#define USE_NOAUDIO
+#define OLC_PGEX_SOUND
+#include "olcPGEX_Sound.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+static constexpr int voices = 64;
+static constexpr unsigned int sampleRate = 44100;
+static constexpr unsigned int blockFrames = 512;
+static constexpr int blocks = 400;
+
+struct RefVoice {
+	int id;
+	long position;
+};
+
+// One call per output sample per channel, walking every voice, with the
+// rounded rate step and the indexing the old mixer did
+static float RefMixerOutput(std::list<RefVoice>& active, int channel, int channels, float timeStep) {
+	float mix = 0.0f;
+	for (RefVoice& v : active) {
+		const olc::SOUND::AudioSample& a = *olc::SOUND::GetAudioSample(v.id);
+		if (v.position >= a.nSamples) v.position = 0;
+		mix += a.fSample[v.position * a.nChannels + std::min(channel, a.nChannels - 1)];
+		if (channel == channels - 1)
+			v.position += long(roundf(float(a.wavHeader.nSamplesPerSec) * timeStep));
+	}
+	return mix;
+}
+
+static void RefMixBlock(std::list<RefVoice>& active, short* out, unsigned int channels) {
+	const float timeStep = 1.0f / float(sampleRate);
+	for (unsigned int n = 0; n < blockFrames; n++) {
+		for (unsigned int c = 0; c < channels; c++) {
+			float s = std::clamp(RefMixerOutput(active, int(c), int(channels), timeStep), -1.0f, 1.0f);
+			out[n * channels + c] = short(s * float(SHRT_MAX));
+		}
+	}
+}
+
+static bool Run(unsigned int channels, const std::vector<int>& ids) {
+	olc::SOUND::InitialiseAudio(sampleRate, channels, 8, blockFrames * channels);
+
+	std::list<RefVoice> active;
+	for (int i = 0; i < voices; i++) {
+		int id = ids[i % ids.size()];
+		olc::SOUND::PlaySample(id, true);
+		active.push_back({ id, 0 });
+	}
+
+	std::vector<short> ref(blockFrames * channels), mixed(blockFrames * channels);
+
+	// Same voices in the same order, so the float sums match exactly
+	for (int b = 0; b < 8; b++) {
+		RefMixBlock(active, ref.data(), channels);
+		olc::SOUND::MixBlock(mixed.data(), blockFrames);
+		for (size_t i = 0; i < ref.size(); i++) {
+			if (ref[i] != mixed[i]) {
+				std::printf("%u channel mix differs at block %d sample %zu: %d vs %d\n", channels, b, i, ref[i], mixed[i]);
+				return false;
+			}
+		}
+	}
+
+	using Clock = std::chrono::steady_clock;
+	auto start = Clock::now();
+	for (int b = 0; b < blocks; b++) RefMixBlock(active, ref.data(), channels);
+	double perSample = std::chrono::duration<double>(Clock::now() - start).count() / blocks;
+
+	start = Clock::now();
+	for (int b = 0; b < blocks; b++) olc::SOUND::MixBlock(mixed.data(), blockFrames);
+	double perBlock = std::chrono::duration<double>(Clock::now() - start).count() / blocks;
+
+	// Share of one core needed to keep up in real time
+	double blockSeconds = double(blockFrames) / sampleRate;
+	std::printf("%8u %14.1f %14.1f %8.1fx %9.2f%%\n", channels, perSample * 1e6, perBlock * 1e6,
+		perSample / perBlock, 100.0 * perBlock / blockSeconds);
+
+	olc::SOUND::StopAll();
+	olc::SOUND::DestroyAudio();
+	return true;
+}
+
+int main() {
+	const char* files[] = {
+		"assets/audio/shoot.wav", "assets/audio/explosion.wav", "assets/audio/player_hit.wav",
+		"assets/audio/menu.wav", "assets/audio/level_complete.wav", "assets/audio/game_over.wav",
+	};
+
+	std::vector<int> ids;
+	for (const char* f : files) {
+		int id = olc::SOUND::LoadAudioSample(f);
+		if (id < 0) {
+			std::printf("could not load %s (run from the repo root)\n", f);
+			return 1;
+		}
+		ids.push_back(id);
+	}
+
+	std::printf("%d voices, %u frames per block\n", voices, blockFrames);
+	std::printf("%8s %14s %14s %9s %10s\n", "channels", "per-sample us", "block us", "speedup", "realtime");
+	if (!Run(1, ids) || !Run(2, ids))
+		return 1;
+	return 0;
+}
@@ -72,18 +72,33 @@
 #define OLC_PGEX_SOUND_H
 
 #include <istream>
+#include <fstream>
 #include <cstring>
 #include <climits>
 #include <condition_variable>
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OLC_SOUND_SSE2
+#include <emmintrin.h>
+#endif
 
 #include "olcPixelGameEngine.h"
 
 #undef min
 #undef max
 
-// Choose a default sound backend
-#if !defined(USE_ALSA) && !defined(USE_OPENAL) && !defined(USE_WINDOWS)
+// Choose a default sound backend. Define USE_NOAUDIO to build with the
+// offline backend instead, e.g. for headless tools on machines without a
+// sound card or ALSA headers: there is no device, the caller paces the
+// mixer with Advance, and the mix is discarded or, after SetOutputFile,
+// written to a WAV file.
+#if !defined(USE_ALSA) && !defined(USE_OPENAL) && !defined(USE_WINDOWS) && !defined(USE_NOAUDIO)
 #ifdef __linux__
 #define USE_ALSA
 #endif
@@ -96,6 +111,11 @@
 #define USE_WINDOWS
 #endif
 
+// Some other platform
+#if !defined(USE_ALSA) && !defined(USE_OPENAL) && !defined(USE_WINDOWS)
+#define USE_NOAUDIO
+#endif
+
 #endif
 
 #ifdef USE_ALSA
@@ -128,6 +148,8 @@ namespace olc
 	{
 		// A representation of an affine transform, used to rotate, scale, offset & shear space
 	public:
+		class AudioStream;
+
 		class AudioSample
 		{
 		public:
@@ -135,24 +157,153 @@ namespace olc
 			AudioSample(std::string sWavFile, olc::ResourcePack *pack = nullptr);
 			olc::rcode LoadFromFile(std::string sWavFile, olc::ResourcePack *pack = nullptr);
 
+			// Takes nFrames of already decoded, interleaved float audio at
+			// nSampleRate. At the device rate fSample points straight at
+			// pData, which must then outlive the sample (e.g. a mapped asset
+			// bundle); at any other rate a resampled copy is made.
+			olc::rcode LoadFromPCM(const float *pData, long nFrames, int nDataChannels, uint32_t nSampleRate);
+
 		public:
 			OLC_WAVEFORMATEX wavHeader;
 			float *fSample = nullptr;
 			long nSamples = 0;
 			int nChannels = 0;
 			bool bSampleValid = false;
+
+			// Peak level of each nEnvelopeFrames run, so the mixer can tell
+			// how loud a voice is at any point without looking at its samples
+			static constexpr long nEnvelopeFrames = 1024;
+			std::vector<float> vecEnvelope;
+			float LevelAt(long nPosition) const;
+			void BuildEnvelope();
+
+			// Set for samples loaded with LoadAudioStream; fSample is then
+			// empty and the voice reads from the stream's ring instead
+			std::shared_ptr<AudioStream> pStream;
 		};
 
+		// A WAV file played from disk. The stream thread reads it a chunk at a
+		// time, converts to float and writes into a fixed ring that the mixer
+		// drains, so a track costs the ring however long it is. Each stream
+		// has one read position, so it plays on at most one voice at a time.
+		class AudioStream
+		{
+		public:
+			static constexpr uint32_t nRingFrames = 32768;
+			static constexpr uint32_t nChunkFrames = 4096;
+
+			bool Open(const std::string &sWavFile);
+
+			// Audio thread: start again from the top on the next fill
+			void Restart(bool bLoop);
+
+		public:
+			int nChannels = 0;
+			long nFrames = 0;
+			std::vector<float> vecRing;
+
+			// Frame counters, only ever increasing; the ring slot is the
+			// counter modulo nRingFrames. The mixer owns nRead, the stream
+			// thread nWrite.
+			alignas(64) std::atomic<uint64_t> nRead{ 0 };
+			alignas(64) std::atomic<uint64_t> nWrite{ 0 };
+
+			// A start bumps nRequest; the mixer leaves the ring alone until
+			// the stream thread has rewound and caught nServed up with it
+			std::atomic<uint32_t> nRequest{ 0 };
+			std::atomic<uint32_t> nServed{ 0 };
+			std::atomic<bool> bLoop{ false };
+			std::atomic<bool> bEnded{ false };
+
+			// Stream thread only
+			std::ifstream ifs;
+			OLC_WAVEFORMATEX wavHeader;
+			std::streampos nDataStart = 0;
+			uint32_t nDataBytes = 0;
+			uint32_t nBytesLeft = 0;
+			uint32_t nFrameBytes = 0;
+			std::vector<char> vecRaw;
+			std::vector<float> vecChunk;
+		};
+
+		// How many copies of one sample may play at once and what happens to
+		// a start beyond that. A zero limit leaves only the voice table's.
+		struct sVoicePolicy
+		{
+			enum class Steal : uint8_t
+			{
+				OLDEST,   // the copy that started first makes way
+				QUIETEST, // the copy with the lowest level right now makes way
+				NONE,     // the new start is dropped
+			};
+			int nMaxVoices = 0;
+			Steal steal = Steal::OLDEST;
+			float fMinRetrigger = 0.0f; // seconds; starts closer than this to the last are dropped
+		};
+
+		// Fixed capacity ring for exactly one producer thread and one consumer
+		// thread. Neither side blocks or allocates; Push fails when it is full.
+		template<typename T, size_t N>
+		class SPSCQueue
+		{
+		public:
+			bool Push(const T& item)
+			{
+				size_t nTail = m_nTail.load(std::memory_order_relaxed);
+				size_t nNext = (nTail + 1) % N;
+				if (nNext == m_nHead.load(std::memory_order_acquire)) return false;
+				m_Items[nTail] = item;
+				m_nTail.store(nNext, std::memory_order_release);
+				return true;
+			}
+
+			bool Pop(T& item)
+			{
+				size_t nHead = m_nHead.load(std::memory_order_relaxed);
+				if (nHead == m_nTail.load(std::memory_order_acquire)) return false;
+				item = m_Items[nHead];
+				m_nHead.store((nHead + 1) % N, std::memory_order_release);
+				return true;
+			}
+
+		private:
+			T m_Items[N];
+			alignas(64) std::atomic<size_t> m_nHead{ 0 };
+			alignas(64) std::atomic<size_t> m_nTail{ 0 };
+		};
+
+		// One playing instance of a sample. Voices live in a fixed table that
+		// only the audio thread touches.
 		struct sCurrentlyPlayingSample
 		{
 			int nAudioSampleID = 0;
 			long nSamplePosition = 0;
-			bool bFinished = false;
+			bool bActive = false;
 			bool bLoop = false;
-			bool bFlagForStop = false;
+			uint32_t nStartOrder = 0; // lower started earlier
 		};
 
-		static std::list<sCurrentlyPlayingSample> listActiveSamples;
+		// Requests from the game thread, applied by the audio thread between blocks
+		struct sVoiceCommand
+		{
+			enum class Type : uint8_t { PLAY, STOP, STOP_ALL, SET_POLICY };
+			Type type = Type::PLAY;
+			int nAudioSampleID = 0;
+			bool bLoop = false;
+			sVoicePolicy policy;
+		};
+
+		// A sample's policy and when it last started, kept by the audio thread
+		struct sPolicyState
+		{
+			sVoicePolicy policy;
+			uint64_t nLastStartFrame = 0;
+			bool bStarted = false;
+		};
+
+		static constexpr int nMaxVoices = 64;
+		static constexpr int nMaxSamples = 256;
+		static constexpr size_t nCommandQueueSize = 256;
 
 	public:
 		static bool InitialiseAudio(unsigned int nSampleRate = 44100, unsigned int nChannels = 1, unsigned int nBlocks = 8, unsigned int nBlockSamples = 512);
@@ -162,19 +313,44 @@ namespace olc
 
 	public:
 		static int LoadAudioSample(std::string sWavFile, olc::ResourcePack *pack = nullptr);
+		static int LoadAudioStream(std::string sWavFile);
+		static int AddAudioSample(const AudioSample &a);
 		static void PlaySample(int id, bool bLoop = false);
 		static void StopSample(int id);
 		static void StopAll();
-		static float GetMixerOutput(int nChannel, float fGlobalTime, float fTimeStep);
+		static void SetVoicePolicy(int id, const sVoicePolicy& policy);
+
+		// The sample behind 'id', or nullptr if no sample has that id yet
+		static const AudioSample *GetAudioSample(int id);
+
+		// Mixes every playing voice into nFrames interleaved frames at the
+		// device rate and channel count, then advances the global time. The
+		// audio backends call this once per block; starts and stops queued
+		// since the previous call take effect at its beginning.
+		static void MixBlock(short* pOut, unsigned int nFrames);
+
+		// Tells the offline backend that fElapsedTime seconds of game time
+		// have passed, so it mixes that many whole blocks. Real devices keep
+		// their own time and ignore it.
+		static void Advance(float fElapsedTime);
+
+#ifdef USE_NOAUDIO
+		// Where the offline backend writes the mix as 16-bit PCM; set it
+		// before InitialiseAudio. Empty (the default) discards the mix.
+		static void SetOutputFile(const std::string &sWavFile);
+#endif
 
 
 	private:
-#ifdef USE_WINDOWS // Windows specific sound management
-		static void CALLBACK waveOutProc(HWAVEOUT hWaveOut, UINT uMsg, DWORD dwParam1, DWORD dwParam2);
+		// Shared by every backend; m_nBlockSamples counts interleaved samples,
+		// so a block is m_nBlockSamples / m_nChannels frames
 		static unsigned int m_nSampleRate;
 		static unsigned int m_nChannels;
-		static unsigned int m_nBlockCount;
 		static unsigned int m_nBlockSamples;
+
+#ifdef USE_WINDOWS // Windows specific sound management
+		static void CALLBACK waveOutProc(HWAVEOUT hWaveOut, UINT uMsg, DWORD dwParam1, DWORD dwParam2);
+		static unsigned int m_nBlockCount;
 		static unsigned int m_nBlockCurrent;
 		static short* m_pBlockMemory;
 		static WAVEHDR *m_pWaveHeaders;
@@ -186,29 +362,67 @@ namespace olc
 
 #ifdef USE_ALSA
 		static snd_pcm_t *m_pPCM;
-		static unsigned int m_nSampleRate;
-		static unsigned int m_nChannels;
-		static unsigned int m_nBlockSamples;
 		static short* m_pBlockMemory;
 #endif
 
+#ifdef USE_NOAUDIO
+		static std::string m_sOutputFile;
+		static std::ofstream m_ofsOutput;
+		static uint32_t m_nOutputBytes;
+		static std::vector<short> m_vecBlock;
+		static double m_dPendingFrames;
+#endif
+
 #ifdef USE_OPENAL
 		static std::queue<ALuint> m_qAvailableBuffers;
 		static ALuint *m_pBuffers;
 		static ALuint m_nSource;
 		static ALCdevice *m_pDevice;
 		static ALCcontext *m_pContext;
-		static unsigned int m_nSampleRate;
-		static unsigned int m_nChannels;
 		static unsigned int m_nBlockCount;
-		static unsigned int m_nBlockSamples;
 		static short* m_pBlockMemory;
 #endif
 
+		static bool ReadWaveHeader(std::istream &is, OLC_WAVEFORMATEX &wavHeader, uint32_t &nDataBytes);
+		static void DecodePCM(const char *pSrc, float *pDst, size_t nCount, const OLC_WAVEFORMATEX &wavHeader);
+		static std::vector<float> Resample(const std::vector<float> &vecIn, int nChannels, uint32_t nFromRate, uint32_t nToRate);
+		static void AddFrames(float *pDst, const float *pSrc, unsigned int nFrames, int nSrcChannels);
+		static void MixStreamVoice(sCurrentlyPlayingSample &s, AudioStream &st, float *pBus, unsigned int nFrames);
+		static bool FillStream(AudioStream &st);
+		static bool FillStreams();
+		static void StreamThread();
+		static void StartStreaming();
+		static void StopStreaming();
+		static std::vector<std::shared_ptr<AudioStream>> m_vecStreams;
+		static std::mutex m_muxStreams;
+		static std::thread m_StreamThread;
+		static std::atomic<bool> m_bStreamThreadActive;
+
+		// Samples are written once, by the game thread, into a slot the
+		// audio thread has never seen, and only then counted in m_nSamples.
+		// The audio thread reads no further than the count, so neither side
+		// ever waits and no slot moves or changes while it is being mixed.
+		static int PublishSample(const AudioSample &a);
+		static AudioSample m_Samples[nMaxSamples];
+		static std::atomic<int> m_nSamples;
+
+		static void ApplyCommands();
+		static void ResetVoices();
+		static void PrepareMixer();
+		static void MixVoice(sCurrentlyPlayingSample &s, float *pBus, unsigned int nFrames);
+		static sCurrentlyPlayingSample m_Voices[nMaxVoices];
+		static SPSCQueue<sVoiceCommand, nCommandQueueSize> m_qCommands;
+		static uint32_t m_nStartOrder;
+		static sPolicyState m_Policies[nMaxSamples + 1]; // by sample id; the default admits every start
+		static uint64_t m_nFramesMixed;
+		static bool AdmitStart(int id);
+
 		static void AudioThread();
 		static std::thread m_AudioThread;
 		static std::atomic<bool> m_bAudioThreadActive;
 		static std::atomic<float> m_fGlobalTime;
+		static std::atomic<bool> m_bMixerReady;
+		static std::vector<float> m_vecBus;
 		static std::function<float(int, float, float)> funcUserSynth;
 		static std::function<float(int, float, float)> funcUserFilter;
 	};
@@ -234,61 +448,31 @@ namespace olc
 	{
 		auto ReadWave = [&](std::istream &is)
 		{
-			char dump[4];
-			is.read(dump, sizeof(char) * 4); // Read "RIFF"
-			if (strncmp(dump, "RIFF", 4) != 0) return olc::FAIL;
-			is.read(dump, sizeof(char) * 4); // Not Interested
-			is.read(dump, sizeof(char) * 4); // Read "WAVE"
-			if (strncmp(dump, "WAVE", 4) != 0) return olc::FAIL;
-
-			// Read Wave description chunk
-			is.read(dump, sizeof(char) * 4); // Read "fmt "
-			unsigned int nHeaderSize = 0;
-			is.read((char*)&nHeaderSize, sizeof(unsigned int)); // Not Interested
-			is.read((char*)&wavHeader, nHeaderSize);// sizeof(WAVEFORMATEX)); // Read Wave Format Structure chunk
-														// Note the -2, because the structure has 2 bytes to indicate its own size
-														// which are not in the wav file
-
-			// Just check if wave format is compatible with olcPGE
-			if (wavHeader.wBitsPerSample != 16 || wavHeader.nSamplesPerSec != 44100)
-				return olc::FAIL;
-
-			// Search for audio data chunk
 			uint32_t nChunksize = 0;
-			is.read(dump, sizeof(char) * 4); // Read chunk header
-			is.read((char*)&nChunksize, sizeof(uint32_t)); // Read chunk size
-			while (strncmp(dump, "data", 4) != 0)
-			{
-				// Not audio data, so just skip it
-				//std::fseek(f, nChunksize, SEEK_CUR);
-				is.seekg(nChunksize, std::istream::cur);
-				is.read(dump, sizeof(char) * 4);
-				is.read((char*)&nChunksize, sizeof(uint32_t));
-			}
+			if (!ReadWaveHeader(is, wavHeader, nChunksize))
+				return olc::FAIL;
 
 			// Finally got to data, so read it all in and convert to float samples
-			nSamples = nChunksize / (wavHeader.nChannels * (wavHeader.wBitsPerSample >> 3));
+			const uint32_t nFrameBytes = wavHeader.nChannels * (wavHeader.wBitsPerSample >> 3);
+			std::vector<char> vecData(nChunksize);
+			is.read(vecData.data(), nChunksize);
+			long nFileFrames = long(uint32_t(is.gcount()) / nFrameBytes);
 			nChannels = wavHeader.nChannels;
 
-			// Create floating point buffer to hold audio sample
-			fSample = new float[nSamples * nChannels];
-			float *pSample = fSample;
+			std::vector<float> vecFloat(size_t(nFileFrames) * nChannels);
+			DecodePCM(vecData.data(), vecFloat.data(), vecFloat.size(), wavHeader);
+			vecData = std::vector<char>();
 
-			// Read in audio data and normalise
-			for (long i = 0; i < nSamples; i++)
-			{
-				for (int c = 0; c < nChannels; c++)
-				{
-					short s = 0;
-					if (!is.eof())
-					{
-						is.read((char*)&s, sizeof(short));
-
-						*pSample = (float)s / (float)(SHRT_MAX);
-						pSample++;
-					}
-				}
-			}
+			// Resampled once here, so every voice steps one frame per output frame
+			const unsigned int nDeviceRate = m_nSampleRate != 0 ? m_nSampleRate : 44100;
+			if (wavHeader.nSamplesPerSec != nDeviceRate)
+				vecFloat = Resample(vecFloat, nChannels, wavHeader.nSamplesPerSec, nDeviceRate);
+
+			// Create floating point buffer to hold audio sample
+			nSamples = long(vecFloat.size() / nChannels);
+			fSample = new float[vecFloat.size()];
+			std::copy(vecFloat.begin(), vecFloat.end(), fSample);
+			BuildEnvelope();
 
 			// All done, flag sound as valid
 			bSampleValid = true;
@@ -314,8 +498,213 @@ namespace olc
 		}
 	}
 
-	// This vector holds all loaded sound samples in memory
-	std::vector<olc::SOUND::AudioSample> vecAudioSamples;
+	olc::rcode SOUND::AudioSample::LoadFromPCM(const float *pData, long nFrames, int nDataChannels, uint32_t nSampleRate)
+	{
+		if (pData == nullptr || nFrames <= 0 || nDataChannels <= 0 || nSampleRate == 0)
+			return olc::FAIL;
+
+		// Describes the data as it was handed in, like a float WAV would
+		wavHeader = OLC_WAVEFORMATEX();
+		wavHeader.wFormatTag = 3;
+		wavHeader.nChannels = uint16_t(nDataChannels);
+		wavHeader.nSamplesPerSec = nSampleRate;
+		wavHeader.wBitsPerSample = 32;
+		wavHeader.nBlockAlign = uint16_t(nDataChannels * sizeof(float));
+		wavHeader.nAvgBytesPerSec = nSampleRate * wavHeader.nBlockAlign;
+		nChannels = nDataChannels;
+
+		const unsigned int nDeviceRate = m_nSampleRate != 0 ? m_nSampleRate : 44100;
+		if (nSampleRate == nDeviceRate)
+		{
+			// The mixer only ever reads fSample
+			fSample = const_cast<float*>(pData);
+			nSamples = nFrames;
+		}
+		else
+		{
+			std::vector<float> vecFloat = Resample(std::vector<float>(pData, pData + size_t(nFrames) * nChannels),
+				nChannels, nSampleRate, nDeviceRate);
+			nSamples = long(vecFloat.size() / nChannels);
+			fSample = new float[vecFloat.size()];
+			std::copy(vecFloat.begin(), vecFloat.end(), fSample);
+		}
+		BuildEnvelope();
+
+		bSampleValid = true;
+		return olc::OK;
+	}
+
+	void SOUND::AudioSample::BuildEnvelope()
+	{
+		vecEnvelope.assign((nSamples + nEnvelopeFrames - 1) / nEnvelopeFrames, 0.0f);
+		for (long i = 0; i < nSamples * nChannels; i++)
+		{
+			float &fPeak = vecEnvelope[(i / nChannels) / nEnvelopeFrames];
+			fPeak = std::max(fPeak, std::fabs(fSample[i]));
+		}
+	}
+
+	float SOUND::AudioSample::LevelAt(long nPosition) const
+	{
+		if (vecEnvelope.empty()) return 0.0f;
+		return vecEnvelope[std::min<size_t>(size_t(nPosition / nEnvelopeFrames), vecEnvelope.size() - 1)];
+	}
+
+	// Reads up to the start of the "data" chunk, leaving 'is' there and its
+	// size in nDataBytes. Accepts 8, 16, 24 and 32-bit integer PCM and 32 or
+	// 64-bit float at any rate; WAVE_FORMAT_EXTENSIBLE files come back with
+	// wFormatTag set to their sub-format.
+	bool SOUND::ReadWaveHeader(std::istream &is, OLC_WAVEFORMATEX &wavHeader, uint32_t &nDataBytes)
+	{
+		char dump[4];
+		is.read(dump, sizeof(char) * 4); // Read "RIFF"
+		if (strncmp(dump, "RIFF", 4) != 0) return false;
+		is.read(dump, sizeof(char) * 4); // Not Interested
+		is.read(dump, sizeof(char) * 4); // Read "WAVE"
+		if (strncmp(dump, "WAVE", 4) != 0) return false;
+
+		// Read Wave description chunk. Extensible headers carry valid bits,
+		// a channel mask and a sub-format GUID after the structure; the
+		// GUID's first two bytes are the real format tag.
+		is.read(dump, sizeof(char) * 4); // Read "fmt "
+		uint32_t nHeaderSize = 0;
+		is.read((char*)&nHeaderSize, sizeof(uint32_t));
+		wavHeader = OLC_WAVEFORMATEX();
+		is.read((char*)&wavHeader, std::min<uint32_t>(nHeaderSize, sizeof(OLC_WAVEFORMATEX)));
+		if (nHeaderSize > sizeof(OLC_WAVEFORMATEX))
+		{
+			std::vector<char> vecExtra(nHeaderSize - sizeof(OLC_WAVEFORMATEX));
+			is.read(vecExtra.data(), vecExtra.size());
+			if (wavHeader.wFormatTag == 0xFFFE && vecExtra.size() >= 8)
+				std::memcpy(&wavHeader.wFormatTag, vecExtra.data() + 6, sizeof(uint16_t));
+		}
+
+		// Just check if wave format is one the decoder knows
+		const uint16_t nBits = wavHeader.wBitsPerSample;
+		bool bPCM = wavHeader.wFormatTag == 1 && (nBits == 8 || nBits == 16 || nBits == 24 || nBits == 32);
+		bool bFloat = wavHeader.wFormatTag == 3 && (nBits == 32 || nBits == 64);
+		if (!(bPCM || bFloat) || wavHeader.nChannels == 0 || wavHeader.nSamplesPerSec == 0)
+			return false;
+
+		// Search for audio data chunk
+		is.read(dump, sizeof(char) * 4); // Read chunk header
+		is.read((char*)&nDataBytes, sizeof(uint32_t)); // Read chunk size
+		while (is && strncmp(dump, "data", 4) != 0)
+		{
+			// Not audio data, so just skip it
+			is.seekg(nDataBytes, std::istream::cur);
+			is.read(dump, sizeof(char) * 4);
+			is.read((char*)&nDataBytes, sizeof(uint32_t));
+		}
+		return bool(is);
+	}
+
+	// Converts nCount interleaved samples of the header's format to floats
+	// in [-1, 1]. Integer formats scale by their largest positive value, so
+	// 16-bit data divides by SHRT_MAX as it always has.
+	void SOUND::DecodePCM(const char *pSrc, float *pDst, size_t nCount, const OLC_WAVEFORMATEX &wavHeader)
+	{
+		const uint8_t *p = (const uint8_t*)pSrc;
+		if (wavHeader.wFormatTag == 3)
+		{
+			if (wavHeader.wBitsPerSample == 32)
+				std::memcpy(pDst, p, nCount * sizeof(float));
+			else
+			{
+				for (size_t i = 0; i < nCount; i++)
+				{
+					double d;
+					std::memcpy(&d, p + i * 8, sizeof(d));
+					pDst[i] = (float)d;
+				}
+			}
+			return;
+		}
+
+		switch (wavHeader.wBitsPerSample)
+		{
+		case 8: // unsigned, centred on 128
+			for (size_t i = 0; i < nCount; i++)
+				pDst[i] = (float)(int(p[i]) - 128) / 127.0f;
+			break;
+		case 16:
+			for (size_t i = 0; i < nCount; i++)
+			{
+				int16_t s;
+				std::memcpy(&s, p + i * 2, sizeof(s));
+				pDst[i] = (float)s / (float)(SHRT_MAX);
+			}
+			break;
+		case 24: // little-endian, sign-extended from the top byte
+			for (size_t i = 0; i < nCount; i++)
+			{
+				int32_t s = int32_t(uint32_t(p[i * 3]) << 8 | uint32_t(p[i * 3 + 1]) << 16 | uint32_t(p[i * 3 + 2]) << 24) >> 8;
+				pDst[i] = (float)s / 8388607.0f;
+			}
+			break;
+		case 32:
+			for (size_t i = 0; i < nCount; i++)
+			{
+				int32_t s;
+				std::memcpy(&s, p + i * 4, sizeof(s));
+				pDst[i] = (float)((double)s / 2147483647.0);
+			}
+			break;
+		}
+	}
+
+	// Linear interpolation from nFromRate to nToRate, run once at load. The
+	// last source frame is held for output frames that land past it.
+	std::vector<float> SOUND::Resample(const std::vector<float> &vecIn, int nChannels, uint32_t nFromRate, uint32_t nToRate)
+	{
+		const size_t nInFrames = vecIn.size() / nChannels;
+		if (nInFrames == 0) return {};
+
+		const size_t nOutFrames = size_t((uint64_t(nInFrames) * nToRate + nFromRate - 1) / nFromRate);
+		std::vector<float> vecOut(nOutFrames * nChannels);
+		const double dStep = (double)nFromRate / (double)nToRate;
+
+		for (size_t n = 0; n < nOutFrames; n++)
+		{
+			double dPos = (double)n * dStep;
+			size_t i0 = std::min(size_t(dPos), nInFrames - 1);
+			size_t i1 = std::min(i0 + 1, nInFrames - 1);
+			float fFrac = (float)(dPos - (double)i0);
+			for (int c = 0; c < nChannels; c++)
+			{
+				float a = vecIn[i0 * nChannels + c], b = vecIn[i1 * nChannels + c];
+				vecOut[n * nChannels + c] = a + (b - a) * fFrac;
+			}
+		}
+		return vecOut;
+	}
+
+	bool SOUND::AudioStream::Open(const std::string &sWavFile)
+	{
+		ifs.open(sWavFile, std::ifstream::binary);
+		if (!ifs.is_open()) return false;
+
+		if (!ReadWaveHeader(ifs, wavHeader, nDataBytes)) return false;
+
+		// Decoded on the fly but never resampled, so only the device rate will do
+		const unsigned int nDeviceRate = m_nSampleRate != 0 ? m_nSampleRate : 44100;
+		if (wavHeader.nSamplesPerSec != nDeviceRate) return false;
+
+		nDataStart = ifs.tellg();
+		nChannels = wavHeader.nChannels;
+		nFrameBytes = uint32_t(nChannels * (wavHeader.wBitsPerSample >> 3));
+		nFrames = long(nDataBytes / nFrameBytes);
+		vecRing.assign(size_t(nRingFrames) * nChannels, 0.0f);
+		vecRaw.resize(size_t(nChunkFrames) * nFrameBytes);
+		vecChunk.resize(size_t(nChunkFrames) * nChannels);
+		return true;
+	}
+
+	void SOUND::AudioStream::Restart(bool bLoopStream)
+	{
+		bLoop.store(bLoopStream, std::memory_order_relaxed);
+		nRequest.fetch_add(1, std::memory_order_release);
+	}
 
 	// This structure represents a sound that is currently playing. It only
 	// holds the sound ID and where this instance of it is up to for its
@@ -331,104 +720,521 @@ namespace olc
 		funcUserFilter = func;
 	}
 
-	// Load a 16-bit WAVE file @ 44100Hz ONLY into memory. A sample ID
+	// Load a WAVE file into memory, resampled to the device rate. Call it
+	// after InitialiseAudio; before that 44100Hz is assumed. A sample ID
 	// number is returned if successful, otherwise -1
 	int SOUND::LoadAudioSample(std::string sWavFile, olc::ResourcePack *pack)
 	{
 
 		olc::SOUND::AudioSample a(sWavFile, pack);
-		if (a.bSampleValid)
+		return AddAudioSample(a);
+	}
+
+	// Register a sample decoded elsewhere, e.g. by AudioSample::LoadFromFile
+	// on a loader thread. Same rules and result as LoadAudioSample, and like
+	// it safe while the mixer runs: no sample already playing moves. Only
+	// the game thread may call it.
+	int SOUND::AddAudioSample(const AudioSample &a)
+	{
+		if (!a.bSampleValid)
+			return -1;
+
+		return PublishSample(a);
+	}
+
+	// Game thread only, like PlaySample: the table has a single writer
+	int SOUND::PublishSample(const AudioSample &a)
+	{
+		int n = m_nSamples.load(std::memory_order_relaxed);
+		assert(n < nMaxSamples && "sample table full, raise nMaxSamples");
+		if (n >= nMaxSamples)
+			return -1;
+
+		m_Samples[n] = a;
+		m_nSamples.store(n + 1, std::memory_order_release);
+		return n + 1;
+	}
+
+	const SOUND::AudioSample *SOUND::GetAudioSample(int id)
+	{
+		if (id < 1 || id > m_nSamples.load(std::memory_order_acquire))
+			return nullptr;
+		return &m_Samples[id - 1];
+	}
+
+	// Open a WAVE file for streaming from disk, e.g. music too long to keep
+	// decoded. Any format LoadAudioSample takes, but already at the device
+	// rate. Only the header is read here. The id works with PlaySample and
+	// friends like any other; -1 if the file is unusable.
+	int SOUND::LoadAudioStream(std::string sWavFile)
+	{
+		auto pStream = std::make_shared<AudioStream>();
+		if (!pStream->Open(sWavFile))
+			return -1;
+
+		olc::SOUND::AudioSample a;
+		a.wavHeader = pStream->wavHeader;
+		a.nChannels = pStream->nChannels;
+		a.nSamples = pStream->nFrames;
+		a.pStream = pStream;
+		a.bSampleValid = true;
+		int id = PublishSample(a);
+		if (id < 0)
+			return -1;
+
 		{
-			vecAudioSamples.push_back(a);
-			return (unsigned int)vecAudioSamples.size();
+			std::lock_guard<std::mutex> lm(m_muxStreams);
+			m_vecStreams.push_back(pStream);
 		}
-		else
-			return -1;
+		StartStreaming();
+		return id;
 	}
 
-	// Add sample 'id' to the mixers sounds to play list
+	// Play, stop and stop-all only queue a command for the audio thread, so
+	// they must all be called from the same (game) thread. A command that
+	// finds the queue full is dropped rather than waiting on the mixer.
+
+	// Start sample 'id' on a free voice at the next block
 	void SOUND::PlaySample(int id, bool bLoop)
 	{
-		olc::SOUND::sCurrentlyPlayingSample a;
-		a.nAudioSampleID = id;
-		a.nSamplePosition = 0;
-		a.bFinished = false;
-		a.bFlagForStop = false;
-		a.bLoop = bLoop;
-		SOUND::listActiveSamples.push_back(a);
+		// Nothing would ever drain the queue before the mixer is set up
+		if (!m_bMixerReady) return;
+
+		sVoiceCommand c;
+		c.type = sVoiceCommand::Type::PLAY;
+		c.nAudioSampleID = id;
+		c.bLoop = bLoop;
+		m_qCommands.Push(c);
 	}
 
+	// Stop the longest playing instance of sample 'id'
 	void SOUND::StopSample(int id)
 	{
-		// Find first occurence of sample id
-		auto s = std::find_if(listActiveSamples.begin(), listActiveSamples.end(), [&](const olc::SOUND::sCurrentlyPlayingSample &s) { return s.nAudioSampleID == id; });
-		if (s != listActiveSamples.end())
-			s->bFlagForStop = true;
+		if (!m_bMixerReady) return;
+
+		sVoiceCommand c;
+		c.type = sVoiceCommand::Type::STOP;
+		c.nAudioSampleID = id;
+		m_qCommands.Push(c);
 	}
 
 	void SOUND::StopAll()
 	{
-		for (auto &s : listActiveSamples)
+		if (!m_bMixerReady) return;
+
+		sVoiceCommand c;
+		c.type = sVoiceCommand::Type::STOP_ALL;
+		m_qCommands.Push(c);
+	}
+
+	// Limits for sample 'id' from the next block on. Policies are kept across
+	// StopAll, so they are normally set once, right after loading.
+	void SOUND::SetVoicePolicy(int id, const sVoicePolicy& policy)
+	{
+		if (!m_bMixerReady) return;
+
+		sVoiceCommand c;
+		c.type = sVoiceCommand::Type::SET_POLICY;
+		c.nAudioSampleID = id;
+		c.policy = policy;
+		m_qCommands.Push(c);
+	}
+
+	// Audio thread only. Applies sample 'id's policy to a start request:
+	// false drops the start, otherwise a voice may have been freed for it.
+	bool SOUND::AdmitStart(int id)
+	{
+		if (id < 1 || id > nMaxSamples) return true;
+		sPolicyState &p = m_Policies[id];
+
+		uint64_t nMinGap = uint64_t(p.policy.fMinRetrigger * (float)m_nSampleRate);
+		if (p.bStarted && m_nFramesMixed - p.nLastStartFrame < nMinGap) return false;
+
+		if (p.policy.nMaxVoices > 0)
 		{
-			s.bFlagForStop = true;
+			int nPlaying = 0;
+			sCurrentlyPlayingSample *pVictim = nullptr;
+			const AudioSample &a = m_Samples[id - 1];
+			for (auto &s : m_Voices)
+			{
+				if (!s.bActive || s.nAudioSampleID != id) continue;
+				nPlaying++;
+				if (!pVictim) pVictim = &s;
+				else if (p.policy.steal == sVoicePolicy::Steal::OLDEST && s.nStartOrder < pVictim->nStartOrder) pVictim = &s;
+				else if (p.policy.steal == sVoicePolicy::Steal::QUIETEST && a.LevelAt(s.nSamplePosition) < a.LevelAt(pVictim->nSamplePosition)) pVictim = &s;
+			}
+
+			if (nPlaying >= p.policy.nMaxVoices)
+			{
+				if (p.policy.steal == sVoicePolicy::Steal::NONE) return false;
+				pVictim->bActive = false;
+			}
 		}
+
+		p.nLastStartFrame = m_nFramesMixed;
+		p.bStarted = true;
+		return true;
 	}
 
-	float SOUND::GetMixerOutput(int nChannel, float fGlobalTime, float fTimeStep)
+	// Audio thread only, called before each block is mixed
+	void SOUND::ApplyCommands()
 	{
-		// Accumulate sample for this channel
-		float fMixerSample = 0.0f;
-
-		for (auto &s : listActiveSamples)
+		sVoiceCommand c;
+		while (m_qCommands.Pop(c))
 		{
-			if (m_bAudioThreadActive)
+			switch (c.type)
+			{
+			case sVoiceCommand::Type::PLAY:
 			{
-				if (s.bFlagForStop)
+				const AudioSample *pSample = GetAudioSample(c.nAudioSampleID);
+				if (!pSample) break;
+				if (!AdmitStart(c.nAudioSampleID)) break;
+				AudioStream *pStream = pSample->pStream.get();
+				if (pStream)
 				{
-					s.bLoop = false;
-					s.bFinished = true;
+					// A stream has one read position, so a new start replaces the old
+					for (auto &s : m_Voices)
+						if (s.bActive && s.nAudioSampleID == c.nAudioSampleID) s.bActive = false;
 				}
-				else
+				auto v = std::find_if(std::begin(m_Voices), std::end(m_Voices), [](const sCurrentlyPlayingSample &s) { return !s.bActive; });
+				if (v == std::end(m_Voices)) break; // every voice busy, the new sound is dropped
+				if (pStream) pStream->Restart(c.bLoop);
+				v->nAudioSampleID = c.nAudioSampleID;
+				v->nSamplePosition = 0;
+				v->bLoop = c.bLoop;
+				v->bActive = true;
+				v->nStartOrder = m_nStartOrder++;
+				break;
+			}
+			case sVoiceCommand::Type::STOP:
+			{
+				sCurrentlyPlayingSample *pOldest = nullptr;
+				for (auto &s : m_Voices)
+					if (s.bActive && s.nAudioSampleID == c.nAudioSampleID && (!pOldest || s.nStartOrder < pOldest->nStartOrder))
+						pOldest = &s;
+				if (pOldest) pOldest->bActive = false;
+				break;
+			}
+			case sVoiceCommand::Type::STOP_ALL:
+				for (auto &s : m_Voices) s.bActive = false;
+				break;
+			case sVoiceCommand::Type::SET_POLICY:
+				if (c.nAudioSampleID < 1 || c.nAudioSampleID > nMaxSamples) break;
+				m_Policies[c.nAudioSampleID].policy = c.policy;
+				break;
+			}
+		}
+	}
+
+	void SOUND::ResetVoices()
+	{
+		sVoiceCommand c;
+		while (m_qCommands.Pop(c)) {}
+		for (auto &s : m_Voices) s.bActive = false;
+	}
+
+	// Sizes the bus for one block, empties the voice table and feeds any
+	// open streams again. Backends call it from InitialiseAudio before their
+	// audio thread starts.
+	void SOUND::PrepareMixer()
+	{
+		ResetVoices();
+		m_vecBus.assign(m_nBlockSamples, 0.0f);
+		m_fGlobalTime = 0.0f;
+		m_bMixerReady = true;
+		StartStreaming();
+	}
+
+	// Adds nFrames frames of an nSrcChannels source to the bus. Runs of
+	// frames are added in one pass.
+	void SOUND::AddFrames(float *pDst, const float *pSrc, unsigned int n, int nSrcChannels)
+	{
+		const unsigned int nOutChannels = m_nChannels;
+
+		if ((unsigned int)nSrcChannels == nOutChannels)
+		{
+			// Same layout as the bus, so one flat add
+			size_t nCount = size_t(n) * nOutChannels, i = 0;
+#if defined(OLC_SOUND_SSE2)
+			for (; i + 4 <= nCount; i += 4)
+				_mm_storeu_ps(pDst + i, _mm_add_ps(_mm_loadu_ps(pDst + i), _mm_loadu_ps(pSrc + i)));
+#endif
+			for (; i < nCount; i++)
+				pDst[i] += pSrc[i];
+		}
+		else if (nSrcChannels == 1 && nOutChannels == 2)
+		{
+			// Mono into stereo, each source sample added to both sides
+			unsigned int i = 0;
+#if defined(OLC_SOUND_SSE2)
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 m = _mm_loadu_ps(pSrc + i);
+				_mm_storeu_ps(pDst + i * 2, _mm_add_ps(_mm_loadu_ps(pDst + i * 2), _mm_unpacklo_ps(m, m)));
+				_mm_storeu_ps(pDst + i * 2 + 4, _mm_add_ps(_mm_loadu_ps(pDst + i * 2 + 4), _mm_unpackhi_ps(m, m)));
+			}
+#endif
+			for (; i < n; i++)
+			{
+				pDst[i * 2] += pSrc[i];
+				pDst[i * 2 + 1] += pSrc[i];
+			}
+		}
+		else
+		{
+			// Mono sources feed every output channel; extra source channels are dropped
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int c = 0; c < nOutChannels; c++)
+					pDst[i * nOutChannels + c] += pSrc[i * nSrcChannels + std::min<int>(c, nSrcChannels - 1)];
+		}
+	}
+
+	// Adds one voice's next nFrames frames to the bus, wrapping or finishing
+	// it at the end of its sample
+	void SOUND::MixVoice(sCurrentlyPlayingSample &s, float *pBus, unsigned int nFrames)
+	{
+		const AudioSample &a = m_Samples[s.nAudioSampleID - 1];
+		if (a.pStream)
+		{
+			MixStreamVoice(s, *a.pStream, pBus, nFrames);
+			return;
+		}
+
+		unsigned int f = 0;
+		while (f < nFrames)
+		{
+			if (s.nSamplePosition >= a.nSamples)
+			{
+				if (!s.bLoop || a.nSamples == 0)
 				{
-					// Calculate sample position
-					s.nSamplePosition += roundf((float)vecAudioSamples[s.nAudioSampleID - 1].wavHeader.nSamplesPerSec * fTimeStep);
-
-					// If sample position is valid add to the mix
-					if (s.nSamplePosition < vecAudioSamples[s.nAudioSampleID - 1].nSamples)
-						fMixerSample += vecAudioSamples[s.nAudioSampleID - 1].fSample[(s.nSamplePosition * vecAudioSamples[s.nAudioSampleID - 1].nChannels) + nChannel];
-					else
-					{
-						if (s.bLoop)
-						{
-							s.nSamplePosition = 0;
-						}
-						else
-							s.bFinished = true; // Else sound has completed
-					}
+					s.bActive = false; // Sound has completed, freeing the voice
+					return;
 				}
+				s.nSamplePosition = 0;
 			}
-			else
-				return 0.0f;
+
+			unsigned int n = (unsigned int)std::min<long>(long(nFrames - f), a.nSamples - s.nSamplePosition);
+			AddFrames(pBus + size_t(f) * m_nChannels, a.fSample + size_t(s.nSamplePosition) * a.nChannels, n, a.nChannels);
+			s.nSamplePosition += n;
+			f += n;
+		}
+	}
+
+	// Takes whatever the stream thread has buffered, up to nFrames, from the
+	// ring. Running dry (or waiting for a rewind) leaves the rest silent
+	// rather than blocking the mixer; the voice ends once a one-shot stream
+	// has been read to the end of its file.
+	void SOUND::MixStreamVoice(sCurrentlyPlayingSample &s, AudioStream &st, float *pBus, unsigned int nFrames)
+	{
+		if (st.nServed.load(std::memory_order_acquire) != st.nRequest.load(std::memory_order_relaxed))
+			return;
+
+		bool bEnded = st.bEnded.load(std::memory_order_acquire);
+		uint64_t nRead = st.nRead.load(std::memory_order_relaxed);
+		uint64_t nWrite = st.nWrite.load(std::memory_order_acquire);
+		unsigned int nAvailable = (unsigned int)std::min<uint64_t>(nFrames, nWrite - nRead);
+
+		unsigned int f = 0;
+		while (f < nAvailable)
+		{
+			// At most two runs, either side of the ring's wrap point
+			uint32_t nSlot = uint32_t((nRead + f) % AudioStream::nRingFrames);
+			unsigned int n = std::min(nAvailable - f, AudioStream::nRingFrames - nSlot);
+			AddFrames(pBus + size_t(f) * m_nChannels, st.vecRing.data() + size_t(nSlot) * st.nChannels, n, st.nChannels);
+			f += n;
 		}
 
-		// If sounds have completed then remove them
-		listActiveSamples.remove_if([](const sCurrentlyPlayingSample &s) {return s.bFinished; });
+		st.nRead.store(nRead + nAvailable, std::memory_order_release);
+		s.nSamplePosition += nAvailable;
+		if (bEnded && nRead + nAvailable == nWrite)
+			s.bActive = false;
+	}
 
-		// The users application might be generating sound, so grab that if it exists
-		if (funcUserSynth != nullptr)
-			fMixerSample += funcUserSynth(nChannel, fGlobalTime, fTimeStep);
+	// Stream thread. Tops one stream's ring up by a chunk, rewinding it first
+	// if the mixer asked for a fresh start. Returns false when there was
+	// nothing to do.
+	bool SOUND::FillStream(AudioStream &st)
+	{
+		uint32_t nRequest = st.nRequest.load(std::memory_order_acquire);
+		if (nRequest == 0) return false; // never played
 
-		// Return the sample via an optional user override to filter the sound
-		if (funcUserFilter != nullptr)
-			return funcUserFilter(nChannel, fGlobalTime, fMixerSample);
-		else
-			return fMixerSample;
+		if (nRequest != st.nServed.load(std::memory_order_relaxed))
+		{
+			// The mixer stays off the ring until nServed moves, so it can be emptied here
+			st.nWrite.store(st.nRead.load(std::memory_order_acquire), std::memory_order_relaxed);
+			st.ifs.clear();
+			st.ifs.seekg(st.nDataStart);
+			st.nBytesLeft = st.nDataBytes;
+			st.bEnded.store(false, std::memory_order_relaxed);
+			st.nServed.store(nRequest, std::memory_order_release);
+		}
+
+		if (st.bEnded.load(std::memory_order_relaxed)) return false;
+
+		uint64_t nWrite = st.nWrite.load(std::memory_order_relaxed);
+		uint64_t nFree = AudioStream::nRingFrames - (nWrite - st.nRead.load(std::memory_order_acquire));
+		if (nFree < AudioStream::nChunkFrames) return false;
+
+		const uint32_t nFrameBytes = st.nFrameBytes;
+		if (st.nBytesLeft < nFrameBytes)
+		{
+			if (!st.bLoop.load(std::memory_order_relaxed) || st.nDataBytes < nFrameBytes)
+			{
+				st.bEnded.store(true, std::memory_order_release);
+				return false;
+			}
+			st.ifs.clear();
+			st.ifs.seekg(st.nDataStart);
+			st.nBytesLeft = st.nDataBytes;
+		}
+
+		uint32_t nChunk = std::min(AudioStream::nChunkFrames, st.nBytesLeft / nFrameBytes);
+		st.ifs.read(st.vecRaw.data(), std::streamsize(nChunk) * nFrameBytes);
+		uint32_t nGot = uint32_t(st.ifs.gcount()) / nFrameBytes;
+		if (nGot == 0)
+		{
+			// File shorter than its header says; treat it as ending here
+			st.nBytesLeft = 0;
+			return true;
+		}
+		st.nBytesLeft -= nGot * nFrameBytes;
+
+		// Normalise, then copy into the ring in at most two runs around its end
+		const size_t nCount = size_t(nGot) * st.nChannels;
+		DecodePCM(st.vecRaw.data(), st.vecChunk.data(), nCount, st.wavHeader);
+		size_t nSlot = size_t(nWrite % AudioStream::nRingFrames) * st.nChannels;
+		size_t nFirst = std::min(nCount, st.vecRing.size() - nSlot);
+		std::copy(st.vecChunk.begin(), st.vecChunk.begin() + nFirst, st.vecRing.begin() + nSlot);
+		std::copy(st.vecChunk.begin() + nFirst, st.vecChunk.begin() + nCount, st.vecRing.begin());
+
+		st.nWrite.store(nWrite + nGot, std::memory_order_release);
+		return true;
+	}
+
+	// One pass over every stream; false when none of them needed data
+	bool SOUND::FillStreams()
+	{
+		bool bBusy = false;
+		std::lock_guard<std::mutex> lm(m_muxStreams);
+		for (auto &st : m_vecStreams)
+			bBusy |= FillStream(*st);
+		return bBusy;
 	}
 
+	// Keeps every stream's ring topped up. A full ring lasts several hundred
+	// milliseconds, so a short nap when all of them are full is plenty.
+	void SOUND::StreamThread()
+	{
+		while (m_bStreamThreadActive)
+		{
+			if (!FillStreams())
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+	}
+
+	// Runs the stream thread once there is a stream to feed. Streams stay
+	// open across DestroyAudio, so PrepareMixer starts it again for them.
+	// The offline backend has no thread; MixBlock fills the rings instead.
+	void SOUND::StartStreaming()
+	{
+#ifndef USE_NOAUDIO
+		if (m_bStreamThreadActive) return;
+		{
+			std::lock_guard<std::mutex> lm(m_muxStreams);
+			if (m_vecStreams.empty()) return;
+		}
+		m_bStreamThreadActive = true;
+		m_StreamThread = std::thread(&SOUND::StreamThread);
+#endif
+	}
+
+	// Called by each backend's DestroyAudio
+	void SOUND::StopStreaming()
+	{
+		m_bStreamThreadActive = false;
+		if (m_StreamThread.joinable())
+			m_StreamThread.join();
+	}
+
+	void SOUND::MixBlock(short* pOut, unsigned int nFrames)
+	{
+		ApplyCommands();
+
+#ifdef USE_NOAUDIO
+		// Filled in step with the mix, so an offline render never underruns
+		// and comes out the same every time
+		while (FillStreams()) {}
+#endif
+
+		const unsigned int nCount = nFrames * m_nChannels;
+		if (m_vecBus.size() < nCount) m_vecBus.resize(nCount);
+		float *pBus = m_vecBus.data();
+		std::fill(pBus, pBus + nCount, 0.0f);
+
+		for (auto &s : m_Voices)
+			if (s.bActive) MixVoice(s, pBus, nFrames);
+
+		// The users application might be generating or filtering sound; these
+		// stay per sample, and cost nothing when not set
+		const float fTimeStep = 1.0f / (float)m_nSampleRate;
+		const float fBlockTime = m_fGlobalTime;
+		if (funcUserSynth != nullptr || funcUserFilter != nullptr)
+		{
+			for (unsigned int n = 0; n < nFrames; n++)
+			{
+				float fTime = fBlockTime + fTimeStep * (float)n;
+				for (unsigned int c = 0; c < m_nChannels; c++)
+				{
+					float &fSample = pBus[n * m_nChannels + c];
+					if (funcUserSynth != nullptr) fSample += funcUserSynth(c, fTime, fTimeStep);
+					if (funcUserFilter != nullptr) fSample = funcUserFilter(c, fTime, fSample);
+				}
+			}
+		}
+
+		// Clip to [-1, 1] and convert, eight samples at a time with saturating packs
+		const float fMaxSample = (float)SHRT_MAX;
+		unsigned int i = 0;
+#if defined(OLC_SOUND_SSE2)
+		const __m128 vMax = _mm_set1_ps(fMaxSample), vMin = _mm_set1_ps(-fMaxSample);
+		for (; i + 8 <= nCount; i += 8)
+		{
+			__m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(pBus + i), vMax), vMin), vMax);
+			__m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(pBus + i + 4), vMax), vMin), vMax);
+			_mm_storeu_si128((__m128i*)(pOut + i), _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b)));
+		}
+#endif
+		for (; i < nCount; i++)
+			pOut[i] = (short)(std::clamp(pBus[i], -1.0f, 1.0f) * fMaxSample);
+
+		m_fGlobalTime = fBlockTime + fTimeStep * (float)nFrames;
+		m_nFramesMixed += nFrames;
+	}
+
+#ifndef USE_NOAUDIO
+	void SOUND::Advance(float)
+	{	}
+#endif
+
+	unsigned int SOUND::m_nSampleRate = 0;
+	unsigned int SOUND::m_nChannels = 0;
+	unsigned int SOUND::m_nBlockSamples = 0;
 	std::thread SOUND::m_AudioThread;
 	std::atomic<bool> SOUND::m_bAudioThreadActive{ false };
 	std::atomic<float> SOUND::m_fGlobalTime{ 0.0f };
-	std::list<SOUND::sCurrentlyPlayingSample> SOUND::listActiveSamples;
+	std::atomic<bool> SOUND::m_bMixerReady{ false };
+	std::vector<float> SOUND::m_vecBus;
+	SOUND::sCurrentlyPlayingSample SOUND::m_Voices[SOUND::nMaxVoices];
+	SOUND::SPSCQueue<SOUND::sVoiceCommand, SOUND::nCommandQueueSize> SOUND::m_qCommands;
+	uint32_t SOUND::m_nStartOrder = 0;
+	SOUND::sPolicyState SOUND::m_Policies[SOUND::nMaxSamples + 1];
+	uint64_t SOUND::m_nFramesMixed = 0;
+	SOUND::AudioSample SOUND::m_Samples[SOUND::nMaxSamples];
+	std::atomic<int> SOUND::m_nSamples{ 0 };
+	std::vector<std::shared_ptr<SOUND::AudioStream>> SOUND::m_vecStreams;
+	std::mutex SOUND::m_muxStreams;
+	std::thread SOUND::m_StreamThread;
+	std::atomic<bool> SOUND::m_bStreamThreadActive{ false };
 	std::function<float(int, float, float)> SOUND::funcUserSynth = nullptr;
 	std::function<float(int, float, float)> SOUND::funcUserFilter = nullptr;
 }
@@ -462,7 +1268,8 @@ namespace olc
 		waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign;
 		waveFormat.cbSize = 0;
 
-		listActiveSamples.clear();
+		// No audio thread yet, so the mixer can be reset directly
+		PrepareMixer();
 
 		// Open Device if valid
 		if (waveOutOpen(&m_hwDevice, WAVE_MAPPER, &waveFormat, (DWORD_PTR)SOUND::waveOutProc, (DWORD_PTR)0, CALLBACK_FUNCTION) != S_OK)
@@ -499,6 +1306,8 @@ namespace olc
 	bool SOUND::DestroyAudio()
 	{
 		m_bAudioThreadActive = false;
+		m_bMixerReady = false;
+		StopStreaming();
 		if(m_AudioThread.joinable())
 			m_AudioThread.join();
 		return false;
@@ -519,17 +1328,6 @@ namespace olc
 	// and then issued to the soundcard.
 	void SOUND::AudioThread()
 	{
-		m_fGlobalTime = 0.0f;
-		static float fTimeStep = 1.0f / (float)m_nSampleRate;
-
-		// Goofy hack to get maximum integer for a type at run-time
-		short nMaxSample = (short)pow(2, (sizeof(short) * 8) - 1) - 1;
-		float fMaxSample = (float)nMaxSample;
-		short nPreviousSample = 0;
-
-		auto tp1 = std::chrono::system_clock::now();
-		auto tp2 = std::chrono::system_clock::now();
-
 		while (m_bAudioThreadActive)
 		{
 			// Wait for block to become available
@@ -547,36 +1345,7 @@ namespace olc
 			if (m_pWaveHeaders[m_nBlockCurrent].dwFlags & WHDR_PREPARED)
 				waveOutUnprepareHeader(m_hwDevice, &m_pWaveHeaders[m_nBlockCurrent], sizeof(WAVEHDR));
 
-			short nNewSample = 0;
-			int nCurrentBlock = m_nBlockCurrent * m_nBlockSamples;
-
-			auto clip = [](float fSample, float fMax)
-			{
-				if (fSample >= 0.0)
-					return fmin(fSample, fMax);
-				else
-					return fmax(fSample, -fMax);
-			};
-
-			tp2 = std::chrono::system_clock::now();
-			std::chrono::duration<float> elapsedTime = tp2 - tp1;
-			tp1 = tp2;
-
-			// Our time per frame coefficient
-			float fElapsedTime = elapsedTime.count();
-
-			for (unsigned int n = 0; n < m_nBlockSamples; n += m_nChannels)
-			{
-				// User Process
-				for (unsigned int c = 0; c < m_nChannels; c++)
-				{
-					nNewSample = (short)(clip(GetMixerOutput(c, m_fGlobalTime + fTimeStep * (float)n, fTimeStep), 1.0) * fMaxSample);
-					m_pBlockMemory[nCurrentBlock + n + c] = nNewSample;
-					nPreviousSample = nNewSample;
-				}				
-			}
-
-			m_fGlobalTime = m_fGlobalTime + fTimeStep * (float)m_nBlockSamples;
+			MixBlock(m_pBlockMemory + m_nBlockCurrent * m_nBlockSamples, m_nBlockSamples / m_nChannels);
 
 			// Send block to sound device
 			waveOutPrepareHeader(m_hwDevice, &m_pWaveHeaders[m_nBlockCurrent], sizeof(WAVEHDR));
@@ -586,10 +1355,7 @@ namespace olc
 		}
 	}
 
-	unsigned int SOUND::m_nSampleRate = 0;
-	unsigned int SOUND::m_nChannels = 0;
 	unsigned int SOUND::m_nBlockCount = 0;
-	unsigned int SOUND::m_nBlockSamples = 0;
 	unsigned int SOUND::m_nBlockCurrent = 0;
 	short* SOUND::m_pBlockMemory = nullptr;
 	WAVEHDR *SOUND::m_pWaveHeaders = nullptr;
@@ -636,7 +1402,8 @@ namespace olc
 		if (rc < 0)
 			return DestroyAudio();
 
-		listActiveSamples.clear();
+		// No audio thread yet, so the mixer can be reset directly
+		PrepareMixer();
 
 		// Allocate Wave|Block Memory
 		m_pBlockMemory = new short[m_nBlockSamples];
@@ -660,10 +1427,16 @@ namespace olc
 	bool SOUND::DestroyAudio()
 	{
 		m_bAudioThreadActive = false;
+		m_bMixerReady = false;
+		StopStreaming();
 		if(m_AudioThread.joinable())
 			m_AudioThread.join();
-		snd_pcm_drain(m_pPCM);
-		snd_pcm_close(m_pPCM);
+		if (m_pPCM != nullptr)
+		{
+			snd_pcm_drain(m_pPCM);
+			snd_pcm_close(m_pPCM);
+			m_pPCM = nullptr;
+		}
 		return false;
 	}
 
@@ -674,41 +1447,12 @@ namespace olc
 	// and then issued to the soundcard.
 	void SOUND::AudioThread()
 	{
-		m_fGlobalTime = 0.0f;
-		static float fTimeStep = 1.0f / (float)m_nSampleRate;
-
-		// Goofy hack to get maximum integer for a type at run-time
-		short nMaxSample = (short)pow(2, (sizeof(short) * 8) - 1) - 1;
-		float fMaxSample = (float)nMaxSample;
-		short nPreviousSample = 0;
-
 		while (m_bAudioThreadActive)
 		{
-			short nNewSample = 0;
-
-			auto clip = [](float fSample, float fMax)
-			{
-				if (fSample >= 0.0)
-					return fmin(fSample, fMax);
-				else
-					return fmax(fSample, -fMax);
-			};
-
-			for (unsigned int n = 0; n < m_nBlockSamples; n += m_nChannels)
-			{
-				// User Process
-				for (unsigned int c = 0; c < m_nChannels; c++)
-				{
-					nNewSample = (short)(GetMixerOutput(c, m_fGlobalTime + fTimeStep * (float)n, fTimeStep), 1.0) * fMaxSample;
-					m_pBlockMemory[n + c] = nNewSample;
-					nPreviousSample = nNewSample;
-				}		
-			}
-
-			m_fGlobalTime = m_fGlobalTime + fTimeStep * (float)m_nBlockSamples;
+			MixBlock(m_pBlockMemory, m_nBlockSamples / m_nChannels);
 
 			// Send block to sound device
-			snd_pcm_uframes_t nLeft = m_nBlockSamples;
+			snd_pcm_uframes_t nLeft = m_nBlockSamples / m_nChannels;
 			short *pBlockPos = m_pBlockMemory;
 			while (nLeft > 0)
 			{
@@ -726,9 +1470,6 @@ namespace olc
 	}
 
 	snd_pcm_t* SOUND::m_pPCM = nullptr;
-	unsigned int SOUND::m_nSampleRate = 0;
-	unsigned int SOUND::m_nChannels = 0;
-	unsigned int SOUND::m_nBlockSamples = 0;
 	short* SOUND::m_pBlockMemory = nullptr;
 }
 
@@ -765,7 +1506,8 @@ namespace olc
 		for (unsigned int i = 0; i < m_nBlockCount; i++)
 			m_qAvailableBuffers.push(m_pBuffers[i]);
 
-		listActiveSamples.clear();
+		// No audio thread yet, so the mixer can be reset directly
+		PrepareMixer();
 
 		// Allocate Wave|Block Memory
 		m_pBlockMemory = new short[m_nBlockSamples];
@@ -782,6 +1524,8 @@ namespace olc
 	bool SOUND::DestroyAudio()
 	{
 		m_bAudioThreadActive = false;
+		m_bMixerReady = false;
+		StopStreaming();
 		if(m_AudioThread.joinable())
 			m_AudioThread.join();
 
@@ -802,14 +1546,6 @@ namespace olc
 	// and then issued to the soundcard.
 	void SOUND::AudioThread()
 	{
-		m_fGlobalTime = 0.0f;
-		static float fTimeStep = 1.0f / (float)m_nSampleRate;
-
-		// Goofy hack to get maximum integer for a type at run-time
-		short nMaxSample = (short)pow(2, (sizeof(short) * 8) - 1) - 1;
-		float fMaxSample = (float)nMaxSample;
-		short nPreviousSample = 0;
-
 		std::vector<ALuint> vProcessed;
 
 		while (m_bAudioThreadActive)
@@ -826,28 +1562,7 @@ namespace olc
 			// Wait until there is a free buffer (ewww)
 			if (m_qAvailableBuffers.empty()) continue;
 
-			short nNewSample = 0;
-
-			auto clip = [](float fSample, float fMax)
-			{
-				if (fSample >= 0.0)
-					return fmin(fSample, fMax);
-				else
-					return fmax(fSample, -fMax);
-			};
-
-			for (unsigned int n = 0; n < m_nBlockSamples; n += m_nChannels)
-			{
-				// User Process
-				for (unsigned int c = 0; c < m_nChannels; c++)
-				{
-					nNewSample = (short)(clip(GetMixerOutput(c, m_fGlobalTime, fTimeStep), 1.0) * fMaxSample);
-					m_pBlockMemory[n + c] = nNewSample;
-					nPreviousSample = nNewSample;
-				}
-
-				m_fGlobalTime = m_fGlobalTime + fTimeStep;
-			}
+			MixBlock(m_pBlockMemory, m_nBlockSamples / m_nChannels);
 
 			// Fill OpenAL data buffer
 			alBufferData(
@@ -873,35 +1588,105 @@ namespace olc
 	ALuint SOUND::m_nSource = 0;
 	ALCdevice *SOUND::m_pDevice = nullptr;
 	ALCcontext *SOUND::m_pContext = nullptr;
-	unsigned int SOUND::m_nSampleRate = 0;
-	unsigned int SOUND::m_nChannels = 0;
 	unsigned int SOUND::m_nBlockCount = 0;
-	unsigned int SOUND::m_nBlockSamples = 0;
 	short* SOUND::m_pBlockMemory = nullptr;
 }
 
-#else // Some other platform
+#else // USE_NOAUDIO: no device, mixed as the caller advances time
 
 namespace olc
 {
+	// No device and no audio thread: the mixer is set up so callers can
+	// drive it with Advance, or call MixBlock themselves, e.g. to benchmark it
 	bool SOUND::InitialiseAudio(unsigned int nSampleRate, unsigned int nChannels, unsigned int nBlocks, unsigned int nBlockSamples)
 	{
+		m_nSampleRate = nSampleRate;
+		m_nChannels = nChannels;
+		m_nBlockSamples = nBlockSamples;
+		m_vecBlock.assign(m_nBlockSamples, 0);
+		m_dPendingFrames = 0.0;
+		m_nOutputBytes = 0;
+
+		if (!m_sOutputFile.empty())
+		{
+			m_ofsOutput.open(m_sOutputFile, std::ofstream::binary | std::ofstream::trunc);
+			if (!m_ofsOutput.is_open())
+				return DestroyAudio();
+
+			// Sizes are left zero and filled in by DestroyAudio
+			OLC_WAVEFORMATEX wavHeader;
+			wavHeader.wFormatTag = 1;
+			wavHeader.nChannels = uint16_t(m_nChannels);
+			wavHeader.nSamplesPerSec = m_nSampleRate;
+			wavHeader.wBitsPerSample = 16;
+			wavHeader.nBlockAlign = uint16_t(m_nChannels * sizeof(short));
+			wavHeader.nAvgBytesPerSec = m_nSampleRate * wavHeader.nBlockAlign;
+			uint32_t nZero = 0, nFormatSize = 16;
+			m_ofsOutput.write("RIFF", 4);
+			m_ofsOutput.write((char*)&nZero, sizeof(uint32_t));
+			m_ofsOutput.write("WAVEfmt ", 8);
+			m_ofsOutput.write((char*)&nFormatSize, sizeof(uint32_t));
+			m_ofsOutput.write((char*)&wavHeader, nFormatSize);
+			m_ofsOutput.write("data", 4);
+			m_ofsOutput.write((char*)&nZero, sizeof(uint32_t));
+		}
+
+		PrepareMixer();
 		return true;
 	}
 
 	// Stop and clean up audio system
 	bool SOUND::DestroyAudio()
 	{
+		m_bMixerReady = false;
+		StopStreaming();
+
+		if (m_ofsOutput.is_open())
+		{
+			uint32_t nRiffSize = 36 + m_nOutputBytes;
+			m_ofsOutput.seekp(4);
+			m_ofsOutput.write((char*)&nRiffSize, sizeof(uint32_t));
+			m_ofsOutput.seekp(40);
+			m_ofsOutput.write((char*)&m_nOutputBytes, sizeof(uint32_t));
+			m_ofsOutput.close();
+		}
 		return false;
 	}
 
+	void SOUND::SetOutputFile(const std::string &sWavFile)
+	{
+		m_sOutputFile = sWavFile;
+	}
+
+	// Mixes as many whole blocks as fElapsedTime covers, carrying the rest
+	// over. Only game time is involved, so the same sequence of calls always
+	// produces the same output, and as fast as the mixer can go.
+	void SOUND::Advance(float fElapsedTime)
+	{
+		if (!m_bMixerReady) return;
+
+		const unsigned int nBlockFrames = m_nBlockSamples / m_nChannels;
+		m_dPendingFrames += (double)fElapsedTime * (double)m_nSampleRate;
+		while (m_dPendingFrames >= (double)nBlockFrames)
+		{
+			MixBlock(m_vecBlock.data(), nBlockFrames);
+			if (m_ofsOutput.is_open())
+			{
+				m_ofsOutput.write((char*)m_vecBlock.data(), m_vecBlock.size() * sizeof(short));
+				m_nOutputBytes += uint32_t(m_vecBlock.size() * sizeof(short));
+			}
+			m_dPendingFrames -= (double)nBlockFrames;
+		}
+	}
 
-	// Audio thread. This loop responds to requests from the soundcard to fill 'blocks'
-	// with audio data. If no requests are available it goes dormant until the sound
-	// card is ready for more data. The block is fille by the "user" in some manner
-	// and then issued to the soundcard.
 	void SOUND::AudioThread()
 	{	}
+
+	std::string SOUND::m_sOutputFile;
+	std::ofstream SOUND::m_ofsOutput;
+	uint32_t SOUND::m_nOutputBytes = 0;
+	std::vector<short> SOUND::m_vecBlock;
+	double SOUND::m_dPendingFrames = 0.0;
 }
 
 #endif
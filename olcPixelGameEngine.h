@@ -435,6 +435,8 @@ int main()
 #include <list>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <fstream>
 #include <map>
 #include <functional>
@@ -1203,14 +1205,64 @@ namespace olc
 	// | Auxilliary components internal to engine                                     |
 	// O------------------------------------------------------------------------------O
 
+	// Vector-like storage that keeps up to N elements inline and only goes to the
+	// heap for more. Decal instances are nearly always quads, so with N = 4 the
+	// per-call DrawDecal family does no allocation; polygons of any size still fit.
+	template<typename T, size_t N>
+	class InlineVector
+	{
+	public:
+		InlineVector() = default;
+		InlineVector(std::initializer_list<T> init) { assign(init); }
+		InlineVector& operator=(std::initializer_list<T> init) { assign(init); return *this; }
+
+		void resize(const size_t n)
+		{
+			if (n > N)
+			{
+				if (count <= N) spill.assign(local, local + count);
+				spill.resize(n);
+			}
+			else if (count > N)
+			{
+				std::copy(spill.begin(), spill.begin() + n, local);
+				spill.clear();
+			}
+			count = n;
+		}
+
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		T* data() { return count > N ? spill.data() : local; }
+		const T* data() const { return count > N ? spill.data() : local; }
+		T* begin() { return data(); }
+		T* end() { return data() + count; }
+		const T* begin() const { return data(); }
+		const T* end() const { return data() + count; }
+		T& operator[](const size_t i) { return data()[i]; }
+		const T& operator[](const size_t i) const { return data()[i]; }
+
+	private:
+		void assign(std::initializer_list<T> init)
+		{
+			resize(0);
+			resize(init.size());
+			std::copy(init.begin(), init.end(), data());
+		}
+
+		T local[N] = {};
+		std::vector<T> spill;
+		size_t count = 0;
+	};
+
 	struct DecalInstance
 	{
 		olc::Decal* decal = nullptr;
-		std::vector<olc::vf2d> pos;
-		std::vector<olc::vf2d> uv;
-		std::vector<float> w;
-		std::vector<float> z;
-		std::vector<olc::Pixel> tint;
+		olc::InlineVector<olc::vf2d, 4> pos;
+		olc::InlineVector<olc::vf2d, 4> uv;
+		olc::InlineVector<float, 4> w;
+		olc::InlineVector<float, 4> z;
+		olc::InlineVector<olc::Pixel, 4> tint;
 		olc::DecalMode mode = olc::DecalMode::NORMAL;
 		olc::DecalStructure structure = olc::DecalStructure::FAN;
 		uint32_t points = 0;
@@ -1507,6 +1559,8 @@ namespace olc
 		void DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& tint);
 		void DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint);
 		void DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<float>& depth, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint);
+		// Queues a prebuilt vertex stream, positions already in clip space, on the current layer
+		void DrawGPUTask(const olc::GPUTask& task);
 
 		// Draws a line in Decal Space
 		void DrawLineDecal(const olc::vf2d& pos1, const olc::vf2d& pos2, Pixel p = olc::WHITE);
@@ -3721,6 +3775,11 @@ namespace olc
 		vLayers[nTargetLayer].vecGPUTasks.push_back(task);
 	}
 
+	void PixelGameEngine::DrawGPUTask(const olc::GPUTask& task)
+	{
+		vLayers[nTargetLayer].vecGPUTasks.push_back(task);
+	}
+
 	void PixelGameEngine::HW3D_DrawLine(const std::array<float, 16>& matModelView, const std::array<float, 4>& pos1, const std::array<float, 4>& pos2, const olc::Pixel col)
 	{
 		GPUTask task;
@@ -5136,26 +5195,680 @@ namespace olc
 namespace olc
 {
 #if defined(OLC_GFX_HEADLESS)
+	// Software renderer for builds without a GPU. Draw calls are recorded as
+	// screen-space triangles; DisplayFrame sorts them into bands of rows and
+	// a pool of worker threads rasterises the bands, each one walking its
+	// triangles in submission order so blending matches the GPU renderers.
+	// Handles layer quads, decals and 2D GPU tasks with texture, tint and the
+	// blend modes (WIREFRAME is drawn filled). Lines, depth testing and face
+	// culling are not emulated.
 	class Renderer_Headless : public olc::Renderer
 	{
 	public:
+		// Worker threads, 0 for one per hardware thread; read on the first frame
+		inline static uint32_t nThreads = 0;
+		// When off, draw calls and texture uploads are dropped unseen, to time
+		// everything but rendering; set it before the engine starts
+		inline static bool bRasterise = true;
+
+		~Renderer_Headless() { StopWorkers(); }
+
+		// The last frame presented, window sized
+		const olc::Sprite& GetFrame() const { return sprFrame; }
+
 		virtual void       PrepareDevice() {};
 		virtual olc::rcode CreateDevice(std::vector<void*> params, bool bFullScreen, bool bVSYNC) { return olc::rcode::OK; }
-		virtual olc::rcode DestroyDevice() { return olc::rcode::OK; }
-		virtual void       DisplayFrame() {}
+		virtual olc::rcode DestroyDevice() { StopWorkers(); return olc::rcode::OK; }
+
+		virtual void DisplayFrame()
+		{
+			if (!bRasterise) return;
+
+			olc::vi2d vSize = ptrPGE->GetWindowSize();
+			if (vSize.x <= 0 || vSize.y <= 0) vSize = vViewPos + vViewSize;
+			if (vSize.x != sprFrame.width || vSize.y != sprFrame.height)
+				sprFrame.SetSize(vSize.x, vSize.y);
+
+			vecBins.resize((sprFrame.height + nBandHeight - 1) / nBandHeight);
+			for (auto& bin : vecBins) bin.clear();
+
+			for (uint32_t i = 0; i < vecTriangles.size(); i++)
+			{
+				const Triangle& t = vecTriangles[i];
+				int nLast = std::min((t.nMaxY - 1) / nBandHeight, int(vecBins.size()) - 1);
+				for (int band = t.nMinY / nBandHeight; band <= nLast; band++)
+					vecBins[band].push_back(i);
+			}
+
+			RunBands();
+
+			vecTriangles.clear();
+			bClearPending = false;
+		}
+
 		virtual void       PrepareDrawing() {}
-		virtual void	   SetDecalMode(const olc::DecalMode& mode) {}
-		virtual void       DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) {}
-		virtual void       DrawDecal(const olc::DecalInstance& decal) {}
-		virtual void       DoGPUTask(const olc::GPUTask& task) {}
-		virtual void	   Set3DProjection(const std::array<float, 16>& mat) {}
-		virtual uint32_t   CreateTexture(const uint32_t width, const uint32_t height, const bool filtered = false, const bool clamp = true) { return 1; };
-		virtual void       UpdateTexture(uint32_t id, olc::Sprite* spr) {}
-		virtual void       ReadTexture(uint32_t id, olc::Sprite* spr) {}
-		virtual uint32_t   DeleteTexture(const uint32_t id) { return 1; }
-		virtual void       ApplyTexture(uint32_t id) {}
-		virtual void       UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) {}
-		virtual void       ClearBuffer(olc::Pixel p, bool bDepth) {}
+		virtual void	   SetDecalMode(const olc::DecalMode& mode) { nDecalMode = mode; }
+
+		virtual void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint)
+		{
+			if (!bRasterise) return;
+			RasterVertex v[4] = {
+				{ ToPixelX(-1.0f), ToPixelY(+1.0f), offset.x, offset.y, 1.0f, tint },
+				{ ToPixelX(-1.0f), ToPixelY(-1.0f), offset.x, scale.y + offset.y, 1.0f, tint },
+				{ ToPixelX(+1.0f), ToPixelY(-1.0f), scale.x + offset.x, scale.y + offset.y, 1.0f, tint },
+				{ ToPixelX(+1.0f), ToPixelY(+1.0f), scale.x + offset.x, offset.y, 1.0f, tint },
+			};
+			QueueTriangle(v[0], v[1], v[2], nBoundTexture, olc::DecalMode::NORMAL);
+			QueueTriangle(v[0], v[2], v[3], nBoundTexture, olc::DecalMode::NORMAL);
+		}
+
+		virtual void DrawDecal(const olc::DecalInstance& decal)
+		{
+			if (!bRasterise || decal.points < 3 || decal.structure == olc::DecalStructure::LINE) return;
+
+			RasterVertex vScratch[4];
+			std::vector<RasterVertex> vecScratch;
+			RasterVertex* v = vScratch;
+			if (decal.points > 4)
+			{
+				vecScratch.resize(decal.points);
+				v = vecScratch.data();
+			}
+
+			for (uint32_t i = 0; i < decal.points; i++)
+				v[i] = { ToPixelX(decal.pos[i].x), ToPixelY(decal.pos[i].y), decal.uv[i].x, decal.uv[i].y, decal.w[i], decal.tint[i] };
+
+			uint32_t tex = decal.decal == nullptr ? 0 : decal.decal->id;
+			QueuePrimitives(v, decal.points, decal.structure, tex, decal.mode);
+		}
+
+		virtual void DoGPUTask(const olc::GPUTask& task)
+		{
+			if (!bRasterise || task.vb.size() < 3 || task.structure == olc::DecalStructure::LINE) return;
+
+			// Same transform as the OpenGL 3.3 renderer: projection * model view
+			std::array<float, 16> m;
+			for (size_t c = 0; c < 4; c++)
+				for (size_t r = 0; r < 4; r++)
+					m[c * 4 + r] =
+					+ matProjection[0 * 4 + r] * task.mvp[c * 4 + 0]
+					+ matProjection[1 * 4 + r] * task.mvp[c * 4 + 1]
+					+ matProjection[2 * 4 + r] * task.mvp[c * 4 + 2]
+					+ matProjection[3 * 4 + r] * task.mvp[c * 4 + 3];
+
+			vecTaskScratch.resize(task.vb.size());
+			for (size_t i = 0; i < task.vb.size(); i++)
+			{
+				const float* p = task.vb[i].p;
+				float cx = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+				float cy = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+				float cw = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+
+				// No near plane clipping, anything behind the eye is dropped
+				float q = cw > 0.0f ? 1.0f / cw : 0.0f;
+				olc::Pixel col = olc::Pixel(task.vb[i].c) * task.tint;
+				vecTaskScratch[i] = { ToPixelX(cx * q), ToPixelY(cy * q), p[4] * q, p[5] * q, q, col };
+			}
+
+			QueuePrimitives(vecTaskScratch.data(), uint32_t(vecTaskScratch.size()), task.structure, task.decal == nullptr ? 0 : task.decal->id, task.mode);
+		}
+
+		virtual void Set3DProjection(const std::array<float, 16>& mat) { matProjection = mat; }
+
+		virtual uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered = false, const bool clamp = true)
+		{
+			uint32_t id;
+			if (!vecFreeTextures.empty())
+			{
+				id = vecFreeTextures.back();
+				vecFreeTextures.pop_back();
+			}
+			else
+			{
+				// Id 0 stays free for "no texture", which samples as white
+				if (vecTextures.empty()) vecTextures.resize(1);
+				id = uint32_t(vecTextures.size());
+				vecTextures.emplace_back();
+			}
+			Texture& t = vecTextures[id];
+			t.nWidth = 0;
+			t.nHeight = 0;
+			t.bFiltered = filtered;
+			t.bClamp = clamp;
+			return id;
+		}
+
+		// Textures are copied, as a GPU would, so a sprite may change or go away
+		// once its decal has been updated
+		virtual void UpdateTexture(uint32_t id, olc::Sprite* spr)
+		{
+			if (!bRasterise || id >= vecTextures.size()) return;
+			Texture& t = vecTextures[id];
+			t.nWidth = spr->width;
+			t.nHeight = spr->height;
+			t.vecData.assign(spr->pColData.begin(), spr->pColData.end());
+		}
+
+		virtual void ReadTexture(uint32_t id, olc::Sprite* spr)
+		{
+			if (id >= vecTextures.size()) return;
+			const Texture& t = vecTextures[id];
+			if (spr->width == t.nWidth && spr->height == t.nHeight)
+				spr->pColData.assign(t.vecData.begin(), t.vecData.end());
+		}
+
+		virtual uint32_t DeleteTexture(const uint32_t id)
+		{
+			if (id > 0 && id < vecTextures.size())
+			{
+				vecTextures[id] = Texture();
+				vecFreeTextures.push_back(id);
+			}
+			return id;
+		}
+
+		virtual void ApplyTexture(uint32_t id) { nBoundTexture = id; }
+
+		virtual void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size)
+		{
+			vViewPos = pos;
+			vViewSize = size;
+		}
+
+		// Everything queued so far would be painted over, so it is dropped
+		virtual void ClearBuffer(olc::Pixel p, bool bDepth)
+		{
+			vecTriangles.clear();
+			pClearColour = p;
+			bClearPending = true;
+		}
+
+	private:
+		// Whole rows rather than square tiles, so texture and frame reads run
+		// along memory; 16 rows still gives every core several bands
+		static constexpr int nBandHeight = 16;
+
+		struct Texture
+		{
+			int32_t nWidth = 0;
+			int32_t nHeight = 0;
+			bool bFiltered = false;
+			bool bClamp = true;
+			std::vector<olc::Pixel> vecData;
+		};
+
+		// Position in frame pixels; u and v are pre-divided like q, so the
+		// texture is sampled at (u / q, v / q)
+		struct RasterVertex
+		{
+			float x, y;
+			float u, v, q;
+			olc::Pixel col;
+		};
+
+		// a * x + b * y + c across the triangle
+		struct Plane
+		{
+			float a = 0.0f, b = 0.0f, c = 0.0f;
+			float At(float x, float y) const { return a * x + b * y + c; }
+		};
+
+		struct Triangle
+		{
+			// Edge functions, positive inside
+			float ea[3], eb[3], ec[3];
+			bool bTopLeft[3];
+			// Where each edge crosses a row: x = ka * y + kc
+			float ka[3], kc[3];
+			Plane u, v, q;
+			Plane r, g, b, a;
+			bool bAffine;     // q is constant, so u and v were divided up front
+			bool bFlatColour; // one colour for the whole triangle
+			olc::Pixel flatColour;
+			int nMinX, nMinY, nMaxX, nMaxY; // pixel bounds, max exclusive
+			uint32_t nTexture;
+			olc::DecalMode mode;
+		};
+
+		olc::DecalMode nDecalMode = olc::DecalMode::NORMAL;
+		std::array<float, 16> matProjection = { {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1} };
+		olc::vi2d vViewPos = { 0, 0 };
+		olc::vi2d vViewSize = { 0, 0 };
+
+		std::vector<Texture> vecTextures;
+		std::vector<uint32_t> vecFreeTextures;
+		uint32_t nBoundTexture = 0;
+
+		olc::Sprite sprFrame;
+		olc::Pixel pClearColour = olc::BLACK;
+		bool bClearPending = false;
+
+		std::vector<Triangle> vecTriangles;
+		std::vector<RasterVertex> vecTaskScratch;
+		std::vector<std::vector<uint32_t>> vecBins;
+
+		// Worker pool: DisplayFrame bumps nGeneration, everyone (the calling
+		// thread included) takes bands from nNextBand until they run out
+		std::vector<std::thread> vecWorkers;
+		std::mutex muxWork;
+		std::condition_variable cvWork;
+		std::condition_variable cvDone;
+		uint64_t nGeneration = 0;
+		uint32_t nWorkersBusy = 0;
+		bool bQuit = false;
+		std::atomic<uint32_t> nNextBand{ 0 };
+
+		float ToPixelX(float x) const { return float(vViewPos.x) + (x + 1.0f) * 0.5f * float(vViewSize.x); }
+		float ToPixelY(float y) const { return float(vViewPos.y) + (1.0f - y) * 0.5f * float(vViewSize.y); }
+
+		void QueuePrimitives(const RasterVertex* v, uint32_t n, olc::DecalStructure structure, uint32_t tex, olc::DecalMode mode)
+		{
+			if (structure == olc::DecalStructure::FAN)
+			{
+				for (uint32_t i = 1; i + 1 < n; i++) QueueTriangle(v[0], v[i], v[i + 1], tex, mode);
+			}
+			else if (structure == olc::DecalStructure::STRIP)
+			{
+				for (uint32_t i = 0; i + 2 < n; i++) QueueTriangle(v[i], v[i + 1], v[i + 2], tex, mode);
+			}
+			else if (structure == olc::DecalStructure::LIST)
+			{
+				for (uint32_t i = 0; i + 2 < n; i += 3) QueueTriangle(v[i], v[i + 1], v[i + 2], tex, mode);
+			}
+		}
+
+		void QueueTriangle(const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2, uint32_t tex, olc::DecalMode mode)
+		{
+			if (v0.q == 0.0f || v1.q == 0.0f || v2.q == 0.0f) return;
+
+			// Clockwise on screen (y down) from here on
+			const RasterVertex* p[3] = { &v0, &v1, &v2 };
+			float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+			if (area == 0.0f || !std::isfinite(area)) return;
+			if (area < 0.0f)
+			{
+				std::swap(p[1], p[2]);
+				area = -area;
+			}
+
+			Triangle t;
+			for (int k = 0; k < 3; k++)
+			{
+				// Edge k runs between the two vertices other than k. The constant
+				// is written so the same edge walked the other way negates exactly,
+				// which keeps shared edges watertight.
+				const RasterVertex& a = *p[(k + 1) % 3];
+				const RasterVertex& b = *p[(k + 2) % 3];
+				t.ea[k] = a.y - b.y;
+				t.eb[k] = b.x - a.x;
+				t.ec[k] = a.x * b.y - b.x * a.y;
+				t.bTopLeft[k] = t.ea[k] > 0.0f || (t.ea[k] == 0.0f && t.eb[k] > 0.0f);
+				t.ka[k] = t.ea[k] != 0.0f ? -t.eb[k] / t.ea[k] : 0.0f;
+				t.kc[k] = t.ea[k] != 0.0f ? -t.ec[k] / t.ea[k] : 0.0f;
+			}
+
+			auto plane = [&](float a0, float a1, float a2)
+			{
+				Plane pl;
+				float inv = 1.0f / area;
+				pl.a = (t.ea[0] * a0 + t.ea[1] * a1 + t.ea[2] * a2) * inv;
+				pl.b = (t.eb[0] * a0 + t.eb[1] * a1 + t.eb[2] * a2) * inv;
+				pl.c = (t.ec[0] * a0 + t.ec[1] * a1 + t.ec[2] * a2) * inv;
+				return pl;
+			};
+
+			t.bAffine = p[0]->q == p[1]->q && p[0]->q == p[2]->q;
+			float s = t.bAffine ? 1.0f / p[0]->q : 1.0f;
+			t.u = plane(p[0]->u * s, p[1]->u * s, p[2]->u * s);
+			t.v = plane(p[0]->v * s, p[1]->v * s, p[2]->v * s);
+			t.q = plane(p[0]->q, p[1]->q, p[2]->q);
+
+			t.bFlatColour = p[0]->col == p[1]->col && p[0]->col == p[2]->col;
+			t.flatColour = p[0]->col;
+			if (!t.bFlatColour)
+			{
+				t.r = plane(p[0]->col.r, p[1]->col.r, p[2]->col.r);
+				t.g = plane(p[0]->col.g, p[1]->col.g, p[2]->col.g);
+				t.b = plane(p[0]->col.b, p[1]->col.b, p[2]->col.b);
+				t.a = plane(p[0]->col.a, p[1]->col.a, p[2]->col.a);
+			}
+
+			// Bounds, clipped to the viewport
+			float fMinX = std::min({ v0.x, v1.x, v2.x }), fMaxX = std::max({ v0.x, v1.x, v2.x });
+			float fMinY = std::min({ v0.y, v1.y, v2.y }), fMaxY = std::max({ v0.y, v1.y, v2.y });
+			t.nMinX = int(std::max(std::floor(fMinX), float(vViewPos.x)));
+			t.nMinY = int(std::max(std::floor(fMinY), float(vViewPos.y)));
+			t.nMaxX = int(std::min(std::ceil(fMaxX), float(vViewPos.x + vViewSize.x)));
+			t.nMaxY = int(std::min(std::ceil(fMaxY), float(vViewPos.y + vViewSize.y)));
+			if (t.nMinX >= t.nMaxX || t.nMinY >= t.nMaxY) return;
+
+			t.nTexture = tex < vecTextures.size() ? tex : 0;
+			t.mode = mode;
+			vecTriangles.push_back(t);
+		}
+
+		void RunBands()
+		{
+			nNextBand = 0;
+
+			if (vecWorkers.empty() && vecBins.size() > 1)
+			{
+				uint32_t n = nThreads ? nThreads : std::max(1u, std::thread::hardware_concurrency());
+				for (uint32_t i = 1; i < n; i++)
+					vecWorkers.emplace_back([this]() { WorkerLoop(); });
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(muxWork);
+				nGeneration++;
+				nWorkersBusy = uint32_t(vecWorkers.size());
+			}
+			cvWork.notify_all();
+
+			RasteriseBands();
+
+			std::unique_lock<std::mutex> lock(muxWork);
+			cvDone.wait(lock, [this]() { return nWorkersBusy == 0; });
+		}
+
+		void WorkerLoop()
+		{
+			uint64_t nSeen = 0;
+			for (;;)
+			{
+				{
+					std::unique_lock<std::mutex> lock(muxWork);
+					cvWork.wait(lock, [&]() { return bQuit || nGeneration != nSeen; });
+					if (bQuit) return;
+					nSeen = nGeneration;
+				}
+
+				RasteriseBands();
+
+				std::lock_guard<std::mutex> lock(muxWork);
+				if (--nWorkersBusy == 0) cvDone.notify_one();
+			}
+		}
+
+		void StopWorkers()
+		{
+			{
+				std::lock_guard<std::mutex> lock(muxWork);
+				bQuit = true;
+			}
+			cvWork.notify_all();
+			for (auto& w : vecWorkers) w.join();
+			vecWorkers.clear();
+			bQuit = false;
+		}
+
+		void RasteriseBands()
+		{
+			for (uint32_t band = nNextBand++; band < vecBins.size(); band = nNextBand++)
+			{
+				int y0 = int(band) * nBandHeight, y1 = std::min(y0 + nBandHeight, sprFrame.height);
+
+				if (bClearPending)
+					std::fill_n(sprFrame.pColData.data() + size_t(y0) * sprFrame.width, size_t(y1 - y0) * sprFrame.width, pClearColour);
+
+				for (uint32_t i : vecBins[band])
+					RasteriseTriangle(vecTriangles[i], y0, y1);
+			}
+		}
+
+		static uint32_t Mul255(uint32_t a, uint32_t b)
+		{
+			uint32_t n = a * b + 128;
+			return (n + (n >> 8)) >> 8;
+		}
+
+		olc::Pixel Fetch(const Texture& t, int x, int y) const
+		{
+			if (t.bClamp)
+			{
+				x = std::clamp(x, 0, t.nWidth - 1);
+				y = std::clamp(y, 0, t.nHeight - 1);
+			}
+			else
+			{
+				x %= t.nWidth; if (x < 0) x += t.nWidth;
+				y %= t.nHeight; if (y < 0) y += t.nHeight;
+			}
+			return t.vecData[size_t(y) * t.nWidth + x];
+		}
+
+		olc::Pixel Sample(const Texture& t, float u, float v) const
+		{
+			float fx = u * float(t.nWidth);
+			float fy = v * float(t.nHeight);
+			if (!t.bFiltered)
+				return Fetch(t, int(std::floor(fx)), int(std::floor(fy)));
+
+			fx -= 0.5f;
+			fy -= 0.5f;
+			float bx = std::floor(fx), by = std::floor(fy);
+			int ix = int(bx), iy = int(by);
+			uint32_t wx = uint32_t((fx - bx) * 256.0f), wy = uint32_t((fy - by) * 256.0f);
+
+			olc::Pixel p00 = Fetch(t, ix, iy), p10 = Fetch(t, ix + 1, iy);
+			olc::Pixel p01 = Fetch(t, ix, iy + 1), p11 = Fetch(t, ix + 1, iy + 1);
+			auto lerp = [&](uint8_t c00, uint8_t c10, uint8_t c01, uint8_t c11)
+			{
+				uint32_t top = c00 * (256 - wx) + c10 * wx;
+				uint32_t bot = c01 * (256 - wx) + c11 * wx;
+				return uint8_t((top * (256 - wy) + bot * wy + 32768) >> 16);
+			};
+			return olc::Pixel(lerp(p00.r, p10.r, p01.r, p11.r), lerp(p00.g, p10.g, p01.g, p11.g),
+				lerp(p00.b, p10.b, p01.b, p11.b), lerp(p00.a, p10.a, p01.a, p11.a));
+		}
+
+		// GL blend equations, for the factors each mode sets in SetDecalMode
+		template<olc::DecalMode mode>
+		static void Blend(olc::Pixel& d, const olc::Pixel s)
+		{
+			uint32_t a = s.a, ia = 255 - s.a;
+			auto sat = [](uint32_t n) { return uint8_t(std::min(n, 255u)); };
+			if constexpr (mode == olc::DecalMode::NORMAL || mode == olc::DecalMode::WIREFRAME)
+			{
+				if (a == 255) { d = s; return; }
+				if (a == 0) return;
+				d = olc::Pixel(sat(Mul255(s.r, a) + Mul255(d.r, ia)), sat(Mul255(s.g, a) + Mul255(d.g, ia)),
+					sat(Mul255(s.b, a) + Mul255(d.b, ia)), sat(Mul255(s.a, a) + Mul255(d.a, ia)));
+			}
+			else if constexpr (mode == olc::DecalMode::ADDITIVE)
+			{
+				if (a == 0) return;
+				d = olc::Pixel(sat(Mul255(s.r, a) + d.r), sat(Mul255(s.g, a) + d.g),
+					sat(Mul255(s.b, a) + d.b), sat(Mul255(s.a, a) + d.a));
+			}
+			else if constexpr (mode == olc::DecalMode::MULTIPLICATIVE)
+			{
+				d = olc::Pixel(sat(Mul255(s.r, d.r) + Mul255(d.r, ia)), sat(Mul255(s.g, d.g) + Mul255(d.g, ia)),
+					sat(Mul255(s.b, d.b) + Mul255(d.b, ia)), sat(Mul255(s.a, d.a) + Mul255(d.a, ia)));
+			}
+			else if constexpr (mode == olc::DecalMode::STENCIL)
+			{
+				d = olc::Pixel(uint8_t(Mul255(d.r, a)), uint8_t(Mul255(d.g, a)), uint8_t(Mul255(d.b, a)), uint8_t(Mul255(d.a, a)));
+			}
+			else if constexpr (mode == olc::DecalMode::ILLUMINATE)
+			{
+				d = olc::Pixel(sat(Mul255(s.r, ia) + Mul255(d.r, a)), sat(Mul255(s.g, ia) + Mul255(d.g, a)),
+					sat(Mul255(s.b, ia) + Mul255(d.b, a)), sat(Mul255(s.a, ia) + Mul255(d.a, a)));
+			}
+		}
+
+		static olc::Pixel Modulate(const olc::Pixel s, const olc::Pixel c)
+		{
+			return olc::Pixel(uint8_t(Mul255(s.r, c.r)), uint8_t(Mul255(s.g, c.g)), uint8_t(Mul255(s.b, c.b)), uint8_t(Mul255(s.a, c.a)));
+		}
+
+		// Four bytes added at once, each clamped at 255
+		static uint32_t AddSaturate(uint32_t a, uint32_t b)
+		{
+			uint32_t low = (a & 0x7F7F7F7F) + (b & 0x7F7F7F7F);
+			uint32_t high = (a ^ b) & 0x80808080;
+			uint32_t carry = ((a & b) | (low & high)) & 0x80808080;
+			return (low ^ high) | ((carry >> 7) * 0xFF);
+		}
+
+		// Blends n pixels from source() into dst, with the mode picked once per span.
+		// The source is taken by value: its stepping state must live in registers,
+		// and through a reference it could alias the bytes being written. Opaque
+		// and clear texels, most of any sprite, are handled inline.
+		template<typename F>
+		static void BlendSpan(olc::Pixel* dst, int n, olc::DecalMode mode, F source)
+		{
+			switch (mode)
+			{
+			case olc::DecalMode::NORMAL:
+			case olc::DecalMode::WIREFRAME:
+				for (int i = 0; i < n; i++)
+				{
+					olc::Pixel s = source();
+					if (s.a == 255) dst[i] = s;
+					else if (s.a != 0) Blend<olc::DecalMode::NORMAL>(dst[i], s);
+				}
+				break;
+			case olc::DecalMode::ADDITIVE:
+				for (int i = 0; i < n; i++)
+				{
+					olc::Pixel s = source();
+					if (s.a == 255) dst[i].n = AddSaturate(dst[i].n, s.n);
+					else if (s.a != 0) Blend<olc::DecalMode::ADDITIVE>(dst[i], s);
+				}
+				break;
+			case olc::DecalMode::MULTIPLICATIVE:
+				for (int i = 0; i < n; i++) Blend<olc::DecalMode::MULTIPLICATIVE>(dst[i], source());
+				break;
+			case olc::DecalMode::STENCIL:
+				for (int i = 0; i < n; i++) Blend<olc::DecalMode::STENCIL>(dst[i], source());
+				break;
+			case olc::DecalMode::ILLUMINATE:
+				for (int i = 0; i < n; i++) Blend<olc::DecalMode::ILLUMINATE>(dst[i], source());
+				break;
+			}
+		}
+
+		void RasteriseTriangle(const Triangle& t, int nBandY0, int nBandY1)
+		{
+			int y0 = std::max(t.nMinY, nBandY0), y1 = std::min(t.nMaxY, nBandY1);
+			int xMin = t.nMinX, xMax = t.nMaxX;
+			if (y0 >= y1 || xMin >= xMax) return;
+
+			const Texture* tex = t.nTexture != 0 && !vecTextures[t.nTexture].vecData.empty() ? &vecTextures[t.nTexture] : nullptr;
+			bool bWhiteTint = t.bFlatColour && t.flatColour == olc::WHITE;
+
+			// Sprites drawn upright at any scale: nearest texel, clamped, no
+			// perspective, so texel coordinates can simply be stepped
+			bool bSimple = tex && t.bAffine && !tex->bFiltered && tex->bClamp && t.bFlatColour;
+
+			for (int y = y0; y < y1; y++)
+			{
+				float py = float(y) + 0.5f;
+
+				// Pixel centres x + 0.5 inside all three edges, as one span. Left
+				// edges own a centre exactly on them, right edges don't.
+				int x0 = xMin, x1 = xMax;
+				bool bEmpty = false;
+				for (int k = 0; k < 3; k++)
+				{
+					if (t.ea[k] == 0.0f)
+					{
+						float K = t.eb[k] * py + t.ec[k];
+						bEmpty |= !(K > 0.0f || (K == 0.0f && t.bTopLeft[k]));
+						continue;
+					}
+					float fCross = std::clamp(t.ka[k] * py + t.kc[k] - 0.5f, float(xMin - 1), float(xMax + 1));
+					int nCeil = int(fCross);
+					if (float(nCeil) < fCross) nCeil++;
+					if (t.ea[k] > 0.0f) x0 = std::max(x0, nCeil);
+					else x1 = std::min(x1, nCeil);
+				}
+				if (bEmpty || x0 >= x1) continue;
+
+				int n = x1 - x0;
+				float px = float(x0) + 0.5f;
+				olc::Pixel* dst = sprFrame.pColData.data() + size_t(y) * sprFrame.width + x0;
+
+				float u = t.u.At(px, py), v = t.v.At(px, py), q = t.q.At(px, py);
+
+				if (bSimple)
+				{
+					// 16.16 fixed point: an integer add per pixel instead of a
+					// float add, whose latency would bound the loop
+					const int w = tex->nWidth, h = tex->nHeight;
+					int64_t fx = int64_t(std::floor(double(u) * w * 65536.0)), dfx = int64_t(double(t.u.a) * w * 65536.0);
+					int64_t fy = int64_t(std::floor(double(v) * h * 65536.0)), dfy = int64_t(double(t.v.a) * h * 65536.0);
+					const olc::Pixel c = t.flatColour;
+
+					if (dfy == 0)
+					{
+						// Upright sprite, the whole span reads one texture row
+						const olc::Pixel* row = tex->vecData.data() + size_t(std::clamp<int64_t>(fy >> 16, 0, h - 1)) * w;
+						int64_t fxLast = fx + dfx * (n - 1);
+						if (w <= 0xFFFF && std::min(fx, fxLast) >= 0 && (std::max(fx, fxLast) >> 16) < w)
+						{
+							// Span stays inside the texture, as it does for sprites
+							// drawn whole, so no clamping per texel
+							uint32_t ux = uint32_t(fx), udx = uint32_t(dfx);
+							auto fetch = [row, ux, udx]() mutable
+							{
+								olc::Pixel p = row[ux >> 16];
+								ux += udx;
+								return p;
+							};
+							if (bWhiteTint) BlendSpan(dst, n, t.mode, fetch);
+							else BlendSpan(dst, n, t.mode, [fetch, c]() mutable { return Modulate(fetch(), c); });
+							continue;
+						}
+						auto fetch = [row, fx, dfx, w]() mutable
+						{
+							olc::Pixel p = row[std::clamp<int64_t>(fx >> 16, 0, w - 1)];
+							fx += dfx;
+							return p;
+						};
+						if (bWhiteTint) BlendSpan(dst, n, t.mode, fetch);
+						else BlendSpan(dst, n, t.mode, [fetch, c]() mutable { return Modulate(fetch(), c); });
+					}
+					else
+					{
+						const olc::Pixel* texels = tex->vecData.data();
+						auto fetch = [texels, fx, dfx, fy, dfy, w, h]() mutable
+						{
+							olc::Pixel p = texels[size_t(std::clamp<int64_t>(fy >> 16, 0, h - 1)) * w + std::clamp<int64_t>(fx >> 16, 0, w - 1)];
+							fx += dfx; fy += dfy;
+							return p;
+						};
+						if (bWhiteTint) BlendSpan(dst, n, t.mode, fetch);
+						else BlendSpan(dst, n, t.mode, [fetch, c]() mutable { return Modulate(fetch(), c); });
+					}
+					continue;
+				}
+
+				float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+				if (!t.bFlatColour) { r = t.r.At(px, py); g = t.g.At(px, py); b = t.b.At(px, py); a = t.a.At(px, py); }
+
+				BlendSpan(dst, n, t.mode, [this, &t, tex, bWhiteTint, u, v, q, r, g, b, a]() mutable
+				{
+					olc::Pixel s = olc::WHITE;
+					if (tex)
+					{
+						if (t.bAffine) s = Sample(*tex, u, v);
+						else { float iq = 1.0f / q; s = Sample(*tex, u * iq, v * iq); }
+					}
+					u += t.u.a; v += t.v.a; q += t.q.a;
+
+					if (!t.bFlatColour)
+					{
+						olc::Pixel c(uint8_t(std::clamp(r, 0.0f, 255.0f)), uint8_t(std::clamp(g, 0.0f, 255.0f)),
+							uint8_t(std::clamp(b, 0.0f, 255.0f)), uint8_t(std::clamp(a, 0.0f, 255.0f)));
+						r += t.r.a; g += t.g.a; b += t.b.a; a += t.a.a;
+						return Modulate(s, c);
+					}
+					return bWhiteTint ? s : Modulate(s, t.flatColour);
+				});
+			}
+		}
 	};
 #endif
 #if defined(OLC_PLATFORM_HEADLESS)
@@ -6540,6 +7253,10 @@ namespace olc
 // O------------------------------------------------------------------------------O
 #pragma endregion
 
+#endif // Headless
+
+// libpng has no display dependency, so it is also available to headless
+// builds that want real sprites (OLC_PGE_HEADLESS + OLC_IMAGE_LIBPNG)
 #pragma region image_libpng
 // O------------------------------------------------------------------------------O
 // | START IMAGE LOADER: libpng, default on linux, requires -lpng  (libpng-dev)   |
@@ -6652,8 +7369,33 @@ namespace olc
 			return olc::rcode::FAIL;
 		}
 
+		// 8 bit RGBA, one row at a time straight from the sprite
 		olc::rcode SaveImageResource(olc::Sprite* spr, const std::string& sImageFile) override
 		{
+			if (spr == nullptr || spr->width <= 0 || spr->height <= 0) return olc::rcode::FAIL;
+
+			FILE* f = fopen(sImageFile.c_str(), "wb");
+			if (!f) return olc::rcode::NO_FILE;
+
+			png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+			png_infop info = png ? png_create_info_struct(png) : nullptr;
+			if (!png || !info || setjmp(png_jmpbuf(png)))
+			{
+				png_destroy_write_struct(&png, &info);
+				fclose(f);
+				return olc::rcode::FAIL;
+			}
+
+			png_init_io(png, f);
+			png_set_IHDR(png, info, spr->width, spr->height, 8, PNG_COLOR_TYPE_RGBA,
+				PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+			png_write_info(png, info);
+			for (int y = 0; y < spr->height; y++)
+				png_write_row(png, (png_const_bytep)(spr->pColData.data() + size_t(y) * spr->width));
+			png_write_end(png, nullptr);
+
+			png_destroy_write_struct(&png, &info);
+			fclose(f);
 			return olc::rcode::OK;
 		}
 	};
@@ -6664,6 +7406,8 @@ namespace olc
 // O------------------------------------------------------------------------------O
 #pragma endregion
 
+#if !defined(OLC_PGE_HEADLESS)
+
 
 // O------------------------------------------------------------------------------O
 // | olcPixelGameEngine Platforms                                                 |
@@ -0,0 +1,132 @@
+#include "asset_bundle.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool AssetBundle::SourceStamp(const std::string& path, uint64_t& bytes, int64_t& time) {
+#ifdef _WIN32
+	struct _stat64 st;
+	if (_stat64(path.c_str(), &st) != 0) return false;
+#else
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0) return false;
+#endif
+	bytes = uint64_t(st.st_size);
+	time = int64_t(st.st_mtime);
+	return true;
+}
+
+bool AssetBundle::Open(const std::string& path) {
+	Close();
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER fileSize;
+	HANDLE hMapping = nullptr;
+	if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0)
+		hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!hMapping) {
+		CloseHandle(hFile);
+		return false;
+	}
+	file = hFile;
+	mapping = hMapping;
+	base = static_cast<const uint8_t*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+	size = size_t(fileSize.QuadPart);
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+	struct stat st;
+	void* p = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+		p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the mapping keeps the file alive
+	if (p != MAP_FAILED) {
+		base = static_cast<const uint8_t*>(p);
+		size = size_t(st.st_size);
+	}
+#endif
+	if (!base) {
+		Close();
+		return false;
+	}
+
+	// Check everything the index points at lies inside the file, so a
+	// truncated or foreign file is turned away here and not while playing
+	Header h;
+	bool ok = size >= sizeof(Header);
+	if (ok) {
+		std::memcpy(&h, base, sizeof(Header));
+		ok = std::memcmp(h.magic, fileMagic, sizeof(fileMagic)) == 0 && h.version == version &&
+			h.indexOffset % alignof(Entry) == 0 && h.indexOffset <= size &&
+			uint64_t(h.count) * sizeof(Entry) <= size - h.indexOffset;
+	}
+	const Entry* entries = ok ? reinterpret_cast<const Entry*>(base + h.indexOffset) : nullptr;
+	for (uint32_t i = 0; ok && i < h.count; i++) {
+		const Entry& e = entries[i];
+		uint64_t nameStart = h.indexOffset + e.nameOffset;
+		ok = e.offset <= size && e.bytes <= size - e.offset && e.offset % 16 == 0 &&
+			nameStart <= size && e.nameLength <= size - nameStart;
+		if (ok && e.kind == IMAGE)
+			ok = uint64_t(e.width) * e.height * sizeof(olc::Pixel) == e.bytes;
+		else if (ok && e.kind == SOUND)
+			ok = uint64_t(e.frames) * e.channels * sizeof(float) == e.bytes && e.channels > 0 && e.sampleRate > 0;
+		if (!ok) break;
+
+		std::string name(reinterpret_cast<const char*>(base + nameStart), e.nameLength);
+		uint64_t sourceSize;
+		int64_t sourceTime;
+		if (SourceStamp(name, sourceSize, sourceTime) && (sourceSize != e.sourceSize || sourceTime != e.sourceTime))
+			stale++;
+		else
+			index[std::move(name)] = &e;
+	}
+	if (!ok) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void AssetBundle::Close() {
+	index.clear();
+	stale = 0;
+#ifdef _WIN32
+	if (base) UnmapViewOfFile(base);
+	if (mapping) CloseHandle(mapping);
+	if (file) CloseHandle(file);
+	mapping = nullptr;
+	file = nullptr;
+#else
+	if (base) munmap(const_cast<uint8_t*>(base), size);
+#endif
+	base = nullptr;
+	size = 0;
+}
+
+const AssetBundle::Entry* AssetBundle::Find(const std::string& name) const {
+	auto it = index.find(name);
+	return it == index.end() ? nullptr : it->second;
+}
+
+olc::Sprite* AssetBundle::LoadSprite(const std::string& path) const {
+	const Entry* e = Find(path);
+	if (!e || e->kind != IMAGE) return new olc::Sprite(path);
+
+	olc::Sprite* sprite = new olc::Sprite(int32_t(e->width), int32_t(e->height));
+	std::memcpy(sprite->pColData.data(), Data(*e), size_t(e->bytes));
+	return sprite;
+}
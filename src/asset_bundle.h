@@ -0,0 +1,83 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Assets decoded ahead of time by bench/bundle_assets.cpp into one file,
+// so loading one at runtime is a lookup plus at most a copy, never a PNG
+// or WAV decode. The file is memory-mapped read-only and every blob starts
+// on a 16-byte boundary, so sound data can be played straight from it.
+// Each entry remembers the size and modification time of the file it was
+// made from; an entry whose file has since changed is left out when the
+// bundle is opened, so that asset comes from the file instead.
+//
+// Layout (little-endian):
+//   Header
+//   blobs    images as olc::Pixel rows, sounds as interleaved float frames
+//   Entry[count], then the names they point at
+struct AssetBundle {
+	static constexpr char fileMagic[8] = { 'O', 'S', 'B', 'U', 'N', 'D', 'L', 'E' };
+	static constexpr uint32_t version = 2;
+
+	enum Kind : uint32_t { IMAGE = 1, SOUND = 2 };
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t count;
+		uint64_t indexOffset;
+	};
+
+	struct Entry {
+		uint64_t offset;
+		uint64_t bytes;
+		uint32_t kind;
+		uint32_t nameOffset; // from indexOffset
+		uint32_t nameLength;
+		uint32_t width, height; // images
+		uint32_t frames, channels, sampleRate; // sounds
+		uint64_t sourceSize; // of the PNG or WAV it was decoded from
+		int64_t sourceTime;  // its modification time, seconds since 1970
+	};
+
+	// Reads the size and modification time the bundler records for the
+	// file at 'path'. False if it cannot be read.
+	static bool SourceStamp(const std::string& path, uint64_t& bytes, int64_t& time);
+
+	AssetBundle() = default;
+	AssetBundle(const AssetBundle&) = delete;
+	AssetBundle& operator=(const AssetBundle&) = delete;
+	~AssetBundle() { Close(); }
+
+	// Maps the file and reads its index. False (and an empty bundle) if
+	// it is missing or not a bundle this build understands. Entries whose
+	// source file has changed since are skipped and counted in Stale();
+	// a missing source file is not a change, so a bundle can ship alone.
+	bool Open(const std::string& path);
+	void Close();
+	bool IsOpen() const { return base != nullptr; }
+
+	// The entry stored under an asset's path, e.g. "assets/sprites/bullet.png"
+	const Entry* Find(const std::string& name) const;
+	const void* Data(const Entry& e) const { return base + e.offset; }
+
+	// The image at 'path' as a new sprite: copied out of the bundle if it
+	// is there, otherwise decoded from disk as before. Safe from any thread.
+	olc::Sprite* LoadSprite(const std::string& path) const;
+
+	size_t Bytes() const { return size; }
+	uint32_t Stale() const { return stale; }
+
+private:
+	const uint8_t* base = nullptr;
+	size_t size = 0;
+	uint32_t stale = 0;
+	std::unordered_map<std::string, const Entry*> index;
+
+#ifdef _WIN32
+	void* file = nullptr;
+	void* mapping = nullptr;
+#endif
+};
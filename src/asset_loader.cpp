@@ -0,0 +1,122 @@
+#include "asset_loader.h"
+
+#include <cstdio>
+#include <memory>
+
+using Clock = std::chrono::steady_clock;
+
+void AssetLoader::Add(std::function<void()> decode, std::function<void()> finish) {
+	Job j;
+	j.decode = std::move(decode);
+	j.finish = std::move(finish);
+	jobs.push_back(std::move(j));
+}
+
+void AssetLoader::AddSprite(const std::string& path, std::function<void(olc::Sprite*)> done) {
+	// Owned by the closures until 'done' takes it
+	auto sprite = std::make_shared<olc::Sprite*>(nullptr);
+	const AssetBundle* from = bundle;
+	Add([sprite, path, from]() { *sprite = from ? from->LoadSprite(path) : new olc::Sprite(path); },
+		[sprite, done]() { done(*sprite); });
+}
+
+void AssetLoader::Start() {
+	started = Clock::now();
+
+	if (threads == 0) {
+		for (size_t i = 0; i < jobs.size(); i++) {
+			auto t0 = Clock::now();
+			jobs[i].decode();
+			jobs[i].decodeSeconds = std::chrono::duration<double>(Clock::now() - t0).count();
+			RunFinish(i);
+		}
+		return;
+	}
+
+	uint32_t n = uint32_t(std::min<size_t>(threads, jobs.size()));
+	for (uint32_t t = 0; t < n; t++)
+		workers.emplace_back([this]() { Worker(); });
+}
+
+void AssetLoader::Worker() {
+	for (;;) {
+		if (stopping.load(std::memory_order_relaxed)) return;
+		size_t i = next.fetch_add(1);
+		if (i >= jobs.size()) return;
+
+		auto t0 = Clock::now();
+		jobs[i].decode();
+		jobs[i].decodeSeconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+		std::lock_guard<std::mutex> lock(mux);
+		ready.push_back(i);
+		decoded.notify_one();
+	}
+}
+
+void AssetLoader::RunFinish(size_t i) {
+	auto t0 = Clock::now();
+	if (jobs[i].finish) jobs[i].finish();
+	finishSeconds += std::chrono::duration<double>(Clock::now() - t0).count();
+
+	if (++finished == jobs.size())
+		wallSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+}
+
+bool AssetLoader::Poll() {
+	if (finished == jobs.size()) return true;
+
+	std::vector<size_t> batch;
+	{
+		std::lock_guard<std::mutex> lock(mux);
+		batch.swap(ready);
+	}
+	for (size_t i : batch) RunFinish(i);
+
+	if (finished < jobs.size()) return false;
+	for (std::thread& w : workers) w.join();
+	workers.clear();
+	return true;
+}
+
+void AssetLoader::Wait() {
+	while (!Poll()) {
+		std::unique_lock<std::mutex> lock(mux);
+		decoded.wait(lock, [this]() { return !ready.empty(); });
+	}
+}
+
+void AssetLoader::Stop() {
+	stopping = true;
+	for (std::thread& w : workers) w.join();
+	workers.clear();
+}
+
+void AssetLoader::Report(std::ostream& os) const {
+	double decodeSeconds = 0.0;
+	for (const Job& j : jobs) decodeSeconds += j.decodeSeconds;
+	double serialSeconds = decodeSeconds + finishSeconds;
+	size_t used = std::min<size_t>(threads, jobs.size());
+
+	char where[32];
+	if (threads == 0)
+		std::snprintf(where, sizeof(where), "serially");
+	else
+		std::snprintf(where, sizeof(where), "on %zu thread%s", used, used == 1 ? "" : "s");
+
+	char text[160];
+	std::snprintf(text, sizeof(text), "Loaded %zu assets in %.1f ms %s (decode %.1f ms, engine thread %.1f ms",
+		jobs.size(), wallSeconds * 1000.0, where, decodeSeconds * 1000.0, finishSeconds * 1000.0);
+	os << text;
+
+	// Per-job times only add up to the serial load while every worker has
+	// a core to itself; past that they include time spent preempted
+	unsigned int cores = std::thread::hardware_concurrency();
+	if (threads != 0 && wallSeconds > 0.0 && (cores == 0 || used <= cores)) {
+		std::snprintf(text, sizeof(text), ", about %.1fx faster than serial", serialSeconds / wallSeconds);
+		os << text;
+	}
+	else if (threads != 0)
+		os << ", more threads than cores: compare with --load-threads 0";
+	os << ")\n";
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+#include "asset_bundle.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Decodes assets on a pool of worker threads while the game keeps drawing.
+// Each job is split in two: 'decode' runs on a worker and must only touch
+// its own data (file reads, PNG and WAV decoding), 'finish' runs later on
+// the engine thread from Poll, where creating decals or registering sounds
+// is safe. With threads = 0 Start runs every job inline instead, which is
+// the serial path the game used to take.
+struct AssetLoader {
+	uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+	// Where AddSprite looks before decoding the file; may be null
+	const AssetBundle* bundle = nullptr;
+
+	// Queues a job; only before Start
+	void Add(std::function<void()> decode, std::function<void()> finish = nullptr);
+
+	// Decodes the image at 'path' (or copies it out of the bundle) and
+	// hands it to 'done' on the engine thread. Failed loads still arrive,
+	// as an empty sprite.
+	void AddSprite(const std::string& path, std::function<void(olc::Sprite*)> done);
+
+	void Start();
+
+	// Runs 'finish' for every job decoded since the last call. True once
+	// all jobs have finished.
+	bool Poll();
+
+	// Blocks until every job has finished
+	void Wait();
+
+	// Lets the workers finish the job they are on and joins them; the rest
+	// are dropped. Safe to call at any time.
+	void Stop();
+
+	size_t Total() const { return jobs.size(); }
+	size_t Done() const { return finished; }
+	float Progress() const { return jobs.empty() ? 1.0f : float(finished) / float(jobs.size()); }
+
+	// Wall time from Start to the last finish, against the decode and
+	// finish time summed over every job, which is what one thread doing
+	// them back to back would take
+	void Report(std::ostream& os) const;
+
+	~AssetLoader() { Stop(); }
+
+private:
+	struct Job {
+		std::function<void()> decode;
+		std::function<void()> finish;
+		double decodeSeconds = 0.0;
+	};
+	std::vector<Job> jobs;
+
+	std::vector<std::thread> workers;
+	std::atomic<size_t> next{ 0 };
+	std::atomic<bool> stopping{ false };
+
+	// Decoded jobs waiting for their finish, guarded by mux
+	std::mutex mux;
+	std::condition_variable decoded;
+	std::vector<size_t> ready;
+
+	size_t finished = 0;
+	double finishSeconds = 0.0;
+	double wallSeconds = 0.0;
+	std::chrono::steady_clock::time_point started;
+
+	void Worker();
+	void RunFinish(size_t i);
+};
@@ -0,0 +1,133 @@
+#include "asset_manager.h"
+
+#include <algorithm>
+#include <cstdio>
+
+AssetManager::~AssetManager() {
+	for (auto& a : assets) Free(*a);
+}
+
+// Released assets only linger until their last handle goes; a new load of
+// the same path gets a fresh entry
+AssetManager::Asset* AssetManager::FindAsset(const std::string& path, Kind kind) const {
+	for (const auto& a : assets) {
+		if (a->kind == kind && !a->released && a->name == path) return a.get();
+	}
+	return nullptr;
+}
+
+void AssetManager::Free(Asset& a) {
+	delete a.decal;
+	delete a.sprite;
+	a.decal = nullptr;
+	a.sprite = nullptr;
+	a.bytes = 0;
+	a.textureBytes = 0;
+}
+
+const char* AssetManager::GroupName(Group group) {
+	return group == Group::STORY ? "story" : "game";
+}
+
+AssetManager::ImageHandle AssetManager::Load(const std::string& path, Group group) {
+	if (Asset* a = FindAsset(path, Kind::IMAGE)) return ImageHandle(a);
+	return Adopt(path, group, bundle ? bundle->LoadSprite(path) : new olc::Sprite(path));
+}
+
+AssetManager::ImageHandle AssetManager::Find(const std::string& path) {
+	Asset* a = FindAsset(path, Kind::IMAGE);
+	return a ? ImageHandle(a) : ImageHandle();
+}
+
+AssetManager::ImageHandle AssetManager::Adopt(const std::string& path, Group group, olc::Sprite* sprite, olc::Decal* decal) {
+	if (!sprite) {
+		delete decal;
+		return ImageHandle();
+	}
+	if (Asset* a = FindAsset(path, Kind::IMAGE)) {
+		if (decal != a->decal) delete decal;
+		if (sprite != a->sprite) delete sprite;
+		return ImageHandle(a);
+	}
+
+	auto a = std::make_unique<Asset>();
+	a->kind = Kind::IMAGE;
+	a->group = group;
+	a->name = path;
+	a->sprite = sprite;
+	a->decal = decal ? decal : new olc::Decal(sprite);
+	a->bytes = sprite->pColData.size() * sizeof(olc::Pixel);
+	a->textureBytes = a->bytes;
+	assets.push_back(std::move(a));
+	return ImageHandle(assets.back().get());
+}
+
+AssetManager::SoundHandle AssetManager::TrackSound(const std::string& path, int id, size_t bytes) {
+	if (id < 1) return SoundHandle();
+	if (Asset* a = FindAsset(path, Kind::SOUND)) return SoundHandle(a);
+
+	auto a = std::make_unique<Asset>();
+	a->kind = Kind::SOUND;
+	a->name = path;
+	a->soundId = id;
+	a->bytes = bytes;
+	a->refs = 1; // held by the mixer
+	assets.push_back(std::move(a));
+	return SoundHandle(assets.back().get());
+}
+
+void AssetManager::ReleaseGroup(Group group) {
+	for (auto& a : assets) {
+		if (a->group == group && a->kind == Kind::IMAGE) a->released = true;
+	}
+}
+
+void AssetManager::Collect() {
+	for (auto& a : assets) {
+		if (a->released) Free(*a);
+	}
+	auto unused = std::stable_partition(assets.begin(), assets.end(),
+		[](const std::unique_ptr<Asset>& a) { return a->refs > 0; });
+	for (auto it = unused; it != assets.end(); ++it) Free(**it);
+	assets.erase(unused, assets.end());
+}
+
+size_t AssetManager::ResidentBytes() const {
+	size_t total = 0;
+	for (const auto& a : assets) total += a->bytes;
+	return total;
+}
+
+size_t AssetManager::TextureBytes() const {
+	size_t total = 0;
+	for (const auto& a : assets) total += a->textureBytes;
+	return total;
+}
+
+void AssetManager::Report(std::ostream& os, const std::string& title) const {
+	const double mb = 1.0 / (1024.0 * 1024.0);
+	char line[160];
+
+	os << title << "\n";
+	size_t bytes = 0, textureBytes = 0, releasedBytes = 0;
+	for (const auto& a : assets) {
+		if (a->refs == 0 || a->released) {
+			releasedBytes += a->bytes + a->textureBytes;
+			continue;
+		}
+		if (a->kind == Kind::IMAGE)
+			std::snprintf(line, sizeof(line), "  %-32s %8.2f MB  texture %8.2f MB  refs %u  %s\n",
+				a->name.c_str(), a->bytes * mb, a->textureBytes * mb, a->refs, GroupName(a->group));
+		else
+			std::snprintf(line, sizeof(line), "  %-32s %8.2f MB  sound\n", a->name.c_str(), a->bytes * mb);
+		os << line;
+		bytes += a->bytes;
+		textureBytes += a->textureBytes;
+	}
+	std::snprintf(line, sizeof(line), "  %-32s %8.2f MB  texture %8.2f MB\n", "total", bytes * mb, textureBytes * mb);
+	os << line;
+	if (releasedBytes > 0) {
+		std::snprintf(line, sizeof(line), "  (%.2f MB released, freed before the next frame)\n", releasedBytes * mb);
+		os << line;
+	}
+}
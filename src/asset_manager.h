@@ -0,0 +1,138 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+#include "asset_bundle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Owns every image the game keeps past startup, one entry per path, and
+// counts how many handles refer to it. Dropping the last handle queues the
+// sprite and decal for Collect, which the game calls at the start of each
+// frame: the decal may still be in the draw queue of the frame that let it
+// go. Sounds cannot be unloaded from the mixer, so a SoundHandle only
+// carries the mixer id and keeps the memory report complete.
+//
+// Every asset also belongs to a group, and a state change that is done with
+// a whole group (leaving a story sequence) releases it in one go with
+// ReleaseGroup: its images are freed at the next Collect however many
+// handles are left, and those handles turn empty.
+//
+// Handles and the manager belong to the engine thread; images decoded on
+// other threads come in through Adopt.
+class AssetManager {
+public:
+	enum class Kind { IMAGE, SOUND };
+
+	enum class Group : uint8_t {
+		GAME,  // kept for the whole run: the atlas, sound effects
+		STORY, // the story sequence on screen
+	};
+
+	struct Asset {
+		Kind kind = Kind::IMAGE;
+		Group group = Group::GAME;
+		std::string name;
+		olc::Sprite* sprite = nullptr;
+		olc::Decal* decal = nullptr;
+		int soundId = -1;
+		size_t bytes = 0;        // CPU copy
+		size_t textureBytes = 0; // uploaded decal
+		uint32_t refs = 0;
+		bool released = false;   // by ReleaseGroup
+	};
+
+	// Reference-counted; what the handle gives access to is up to the
+	// typed handles below
+	class Handle {
+	public:
+		Handle() = default;
+		Handle(const Handle& other) : asset(other.asset) { if (asset) asset->refs++; }
+		Handle(Handle&& other) noexcept : asset(other.asset) { other.asset = nullptr; }
+		Handle& operator=(Handle other) noexcept { std::swap(asset, other.asset); return *this; }
+		~Handle() { if (asset) asset->refs--; }
+
+		explicit operator bool() const { return asset && !asset->released; }
+		void Reset() { Handle().Swap(*this); }
+
+	protected:
+		explicit Handle(Asset* a) : asset(a) { asset->refs++; }
+		Asset* Get() const { return *this ? asset : nullptr; }
+
+	private:
+		void Swap(Handle& other) noexcept { std::swap(asset, other.asset); }
+		Asset* asset = nullptr;
+	};
+
+	class ImageHandle : public Handle {
+	public:
+		ImageHandle() = default;
+		olc::Sprite* Sprite() const { return Get() ? Get()->sprite : nullptr; }
+		olc::Decal* Decal() const { return Get() ? Get()->decal : nullptr; }
+
+	private:
+		friend class AssetManager;
+		explicit ImageHandle(Asset* a) : Handle(a) {}
+	};
+
+	class SoundHandle : public Handle {
+	public:
+		SoundHandle() = default;
+		// The mixer's sample id, or -1, which PlaySample ignores
+		int Id() const { return Get() ? Get()->soundId : -1; }
+
+	private:
+		friend class AssetManager;
+		explicit SoundHandle(Asset* a) : Handle(a) {}
+	};
+
+	// Where Load looks before decoding the file; may be null
+	const AssetBundle* bundle = nullptr;
+
+	AssetManager() = default;
+	AssetManager(const AssetManager&) = delete;
+	AssetManager& operator=(const AssetManager&) = delete;
+	~AssetManager();
+
+	// The image at 'path' with its decal, loaded into 'group' now unless it
+	// is already resident (or waiting to be collected)
+	ImageHandle Load(const std::string& path, Group group);
+
+	// The resident image at 'path', or an empty handle
+	ImageHandle Find(const std::string& path);
+
+	// Takes ownership of an image decoded elsewhere and gives it a decal,
+	// unless one is passed in. If 'path' is already resident the new copy
+	// is freed and the existing one returned, in the group it already has.
+	// A null sprite gives an empty handle.
+	ImageHandle Adopt(const std::string& path, Group group, olc::Sprite* sprite, olc::Decal* decal = nullptr);
+
+	// Records sample 'id' registered with the mixer, which keeps it for
+	// good. A failed registration (id < 1) gives an empty handle.
+	SoundHandle TrackSound(const std::string& path, int id, size_t bytes);
+
+	// Releases every asset in 'group' at once; see the class comment
+	void ReleaseGroup(Group group);
+
+	// Frees every image no handle refers to any more, and every image in a
+	// released group
+	void Collect();
+
+	size_t ResidentBytes() const;
+	size_t TextureBytes() const;
+
+	// Every asset still referenced, with its size, then the totals. Images
+	// already released but not yet collected are counted separately.
+	void Report(std::ostream& os, const std::string& title) const;
+
+private:
+	std::vector<std::unique_ptr<Asset>> assets;
+
+	Asset* FindAsset(const std::string& path, Kind kind) const;
+	static void Free(Asset& a);
+	static const char* GroupName(Group group);
+};
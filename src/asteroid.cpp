@@ -1,34 +1,27 @@
 #include "asteroid.h"
 
-void Asteroid::Update(float dt, int screenH) {
-	pos += vel * dt;
-	if (pos.y - r > screenH + 14.0f)
-		alive = false;
+void Asteroids::Update(float dt, int screenH) {
+	Integrate(dt);
 
-}
+	const float limit = screenH + 14.0f;
+	for (size_t i = 0; i < Size(); i++) {
+		if (y[i] - r[i] > limit)
+			alive[i] = 0;
+	}
 
-void Asteroid::Draw(olc::PixelGameEngine* pge) {
-    if (!alive) return;
+}
 
-    if (decal) {
+void Asteroids::Draw(olc::PixelGameEngine* pge, SpriteBatch& batch, float alpha) {
+    if (sprite) {
         // Make sprite height = 2 * r (so visual size matches collision)
-        float desiredDiameter = r * 2.0f;  // 28 if r = 14
-
-        float sw = float(decal->sprite->width);
-        float sh = float(decal->sprite->height);
-
-        // uniform scale so HEIGHT becomes 2r
-        float scale = desiredDiameter / sh;
-        olc::vf2d vScale = { scale, scale };
-
-        // scaled size so we can center on pos
-        olc::vf2d scaledSize = { sw * scale, sh * scale };
-        olc::vf2d drawPos = pos - scaledSize * 0.5f;
-
-        pge->DrawDecal(drawPos, decal, vScale);
+        DrawScaled(batch, alpha, 2.0f, false);
     }
     else {
-        pge->FillCircle(int(pos.x), int(pos.y), int(r), olc::GREY);
+        for (size_t i = 0; i < Size(); i++) {
+            if (!alive[i]) continue;
+            olc::vf2d p = DrawPos(i, alpha);
+            pge->FillCircle(int(p.x), int(p.y), int(r[i]), olc::GREY);
+        }
     }
 }
 
@@ -1,14 +1,8 @@
 #pragma once
-#include "olcPixelGameEngine.h"
-
-struct Asteroid {
-	olc::vf2d pos, vel;
-	float r = 24.0f;
-	bool alive = true;
-
-	olc::Decal* decal = nullptr;
+#include "circle_array.h"
 
+struct Asteroids : CircleArray {
 	void Update(float dt, int screenH);
-	void Draw(olc::PixelGameEngine* pge);
+	void Draw(olc::PixelGameEngine* pge, SpriteBatch& batch, float alpha);
 
 };
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+#include "sprite_batch.h"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Structure-of-arrays storage for the simple circular entities.
+// Hot loops (integration, culling, collision) only walk the float arrays
+// they need; the sprite is shared by every instance of a type.
+//
+// Works as a pool: Reserve() sizes every array up front, so gameplay frames
+// never touch the heap while the capacity holds. An Add() past it still
+// succeeds, growing the arrays, and is counted in 'overflows' so the pool
+// report shows which capacity was too small. Instances keep the order they
+// were added in, so "lowest index" always means "oldest".
+struct CircleArray {
+	std::vector<float> x, y;
+	std::vector<float> vx, vy;
+	std::vector<float> r;
+	std::vector<uint8_t> alive;
+
+	// Position at the start of the current tick, for render interpolation
+	std::vector<float> prevX, prevY;
+
+	SpriteRegion sprite;
+
+	size_t capacity = 0;
+	size_t highWater = 0;
+	size_t overflows = 0;
+
+	size_t Size() const { return x.size(); }
+	olc::vf2d Pos(size_t i) const { return { x[i], y[i] }; }
+
+	// Where to draw instance i, 'alpha' of the way from last tick to this one
+	olc::vf2d DrawPos(size_t i, float alpha) const {
+		return { prevX[i] + (x[i] - prevX[i]) * alpha, prevY[i] + (y[i] - prevY[i]) * alpha };
+	}
+
+	// Sets the pool size and resets the high-water mark and overflow count.
+	// Only grows memory, so calling it at every level start is cheap once the
+	// biggest level ran.
+	template<typename... Extra>
+	void Reserve(size_t cap, std::vector<Extra>&... extra) {
+		capacity = cap;
+		highWater = Size();
+		overflows = 0;
+		x.reserve(cap); y.reserve(cap);
+		vx.reserve(cap); vy.reserve(cap);
+		r.reserve(cap);
+		alive.reserve(cap);
+		prevX.reserve(cap); prevY.reserve(cap);
+		(extra.reserve(cap), ...);
+	}
+
+	// Returns the new slot, always the last one
+	int Add(const olc::vf2d& pos, const olc::vf2d& vel, float radius) {
+		if (Size() >= capacity) overflows++;
+
+		x.push_back(pos.x);
+		y.push_back(pos.y);
+		vx.push_back(vel.x);
+		vy.push_back(vel.y);
+		r.push_back(radius);
+		alive.push_back(1);
+		prevX.push_back(pos.x);
+		prevY.push_back(pos.y);
+
+		highWater = std::max(highWater, Size());
+		return int(Size() - 1);
+	}
+
+	void Clear() {
+		x.clear(); y.clear();
+		vx.clear(); vy.clear();
+		r.clear();
+		alive.clear();
+		prevX.clear(); prevY.clear();
+	}
+
+	// Called at the start of every simulation tick
+	void SavePrevious() {
+		std::copy(x.begin(), x.end(), prevX.begin());
+		std::copy(y.begin(), y.end(), prevY.begin());
+	}
+
+	// Straight-line motion for every instance, no branches so it vectorizes
+	void Integrate(float dt) {
+		const size_t n = Size();
+		float* px = x.data();
+		float* py = y.data();
+		const float* pvx = vx.data();
+		const float* pvy = vy.data();
+		for (size_t i = 0; i < n; i++) {
+			px[i] += pvx[i] * dt;
+			py[i] += pvy[i] * dt;
+		}
+	}
+
+	// Stable compaction: every live instance moves down over the dead ones
+	// before it, in order. Types with extra per-instance arrays pass them in
+	// so they move in step. Shrinking never reallocates.
+	template<typename... Extra>
+	void RemoveDead(std::vector<Extra>&... extra) {
+		size_t n = 0;
+		for (size_t i = 0; i < Size(); i++) {
+			if (!alive[i]) continue;
+			if (i != n) {
+				x[n] = x[i]; y[n] = y[i];
+				vx[n] = vx[i]; vy[n] = vy[i];
+				r[n] = r[i];
+				alive[n] = alive[i];
+				prevX[n] = prevX[i]; prevY[n] = prevY[i];
+				((extra[n] = extra[i]), ...);
+			}
+			n++;
+		}
+		x.resize(n); y.resize(n);
+		vx.resize(n); vy.resize(n);
+		r.resize(n);
+		alive.resize(n);
+		prevX.resize(n); prevY.resize(n);
+		(extra.resize(n), ...);
+	}
+
+	// Draws the shared sprite centred on every live instance, scaled so the
+	// sprite's height (or longest side) spans sizePerRadius * r pixels.
+	// All instances go into the caller's open batch.
+	void DrawScaled(SpriteBatch& batch, float alpha, float sizePerRadius, bool fitLongestSide) const {
+		float sw = sprite.size.x;
+		float sh = sprite.size.y;
+		float ref = fitLongestSide ? std::max(sw, sh) : sh;
+
+		batch.Use(sprite);
+		for (size_t i = 0; i < Size(); i++) {
+			if (!alive[i]) continue;
+
+			float scale = r[i] * sizePerRadius / ref;
+			olc::vf2d vScale = { scale, scale };
+			olc::vf2d scaledSize = { sw * scale, sh * scale };
+			olc::vf2d drawPos = DrawPos(i, alpha) - scaledSize * 0.5f;
+
+			batch.Add(drawPos, vScale);
+		}
+	}
+};
@@ -0,0 +1,136 @@
+#include "circle_kernel.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define CIRCLE_KERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 code inside functions tagged for it,
+// MSVC accepts the intrinsics anywhere
+#if defined(CIRCLE_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CIRCLE_KERNEL_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define CIRCLE_KERNEL_AVX2_TARGET
+#endif
+
+// Handles the last count % 8 circles, and everything on non-x86 builds
+static void ScalarRange(float cx, float cy, float cr,
+	const float* x, const float* y, const float* r, size_t begin, size_t count, uint8_t* masks) {
+	for (size_t i = begin; i < count; i++) {
+		if ((i & 7) == 0) masks[i >> 3] = 0;
+
+		float dx = cx - x[i];
+		float dy = cy - y[i];
+		float hitR = cr + r[i];
+		if (dx * dx + dy * dy <= hitR * hitR)
+			masks[i >> 3] |= uint8_t(1u << (i & 7));
+	}
+}
+
+void CircleOverlapMasksScalar(float cx, float cy, float cr,
+	const float* x, const float* y, const float* r, size_t count, uint8_t* masks) {
+	ScalarRange(cx, cy, cr, x, y, r, 0, count, masks);
+}
+
+#if defined(CIRCLE_KERNEL_X86)
+
+static void OverlapSSE2(float cx, float cy, float cr,
+	const float* x, const float* y, const float* r, size_t count, uint8_t* masks) {
+	const __m128 vcx = _mm_set1_ps(cx);
+	const __m128 vcy = _mm_set1_ps(cy);
+	const __m128 vcr = _mm_set1_ps(cr);
+
+	size_t full = count & ~size_t(7);
+	for (size_t i = 0; i < full; i += 8) {
+		int bits = 0;
+		for (int half = 0; half < 2; half++) {
+			size_t n = i + half * 4;
+			__m128 dx = _mm_sub_ps(vcx, _mm_loadu_ps(x + n));
+			__m128 dy = _mm_sub_ps(vcy, _mm_loadu_ps(y + n));
+			__m128 hitR = _mm_add_ps(vcr, _mm_loadu_ps(r + n));
+			__m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+			bits |= _mm_movemask_ps(_mm_cmple_ps(d2, _mm_mul_ps(hitR, hitR))) << (half * 4);
+		}
+		masks[i >> 3] = uint8_t(bits);
+	}
+
+	ScalarRange(cx, cy, cr, x, y, r, full, count, masks);
+}
+
+CIRCLE_KERNEL_AVX2_TARGET
+static void OverlapAVX2(float cx, float cy, float cr,
+	const float* x, const float* y, const float* r, size_t count, uint8_t* masks) {
+	const __m256 vcx = _mm256_set1_ps(cx);
+	const __m256 vcy = _mm256_set1_ps(cy);
+	const __m256 vcr = _mm256_set1_ps(cr);
+
+	size_t full = count & ~size_t(7);
+	for (size_t i = 0; i < full; i += 8) {
+		__m256 dx = _mm256_sub_ps(vcx, _mm256_loadu_ps(x + i));
+		__m256 dy = _mm256_sub_ps(vcy, _mm256_loadu_ps(y + i));
+		__m256 hitR = _mm256_add_ps(vcr, _mm256_loadu_ps(r + i));
+		__m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		__m256 hit = _mm256_cmp_ps(d2, _mm256_mul_ps(hitR, hitR), _CMP_LE_OQ);
+		masks[i >> 3] = uint8_t(_mm256_movemask_ps(hit));
+	}
+
+	// The tail runs legacy SSE code; clear the upper halves first or every
+	// call pays the AVX/SSE transition penalty (GCC skips it on the tail call)
+	_mm256_zeroupper();
+	ScalarRange(cx, cy, cr, x, y, r, full, count, masks);
+}
+
+static bool CpuHasAVX2() {
+#if defined(_MSC_VER)
+	int info[4] = {};
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+
+	// AVX2 also needs the OS to save the YMM registers
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx) return false;
+	if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+using OverlapFn = void(*)(float, float, float, const float*, const float*, const float*, size_t, uint8_t*);
+
+struct KernelChoice {
+	OverlapFn fn;
+	const char* name;
+};
+
+static KernelChoice PickKernel() {
+#if defined(CIRCLE_KERNEL_X86)
+	if (CpuHasAVX2()) return { OverlapAVX2, "avx2" };
+	return { OverlapSSE2, "sse2" };
+#else
+	return { CircleOverlapMasksScalar, "scalar" };
+#endif
+}
+
+static const KernelChoice& Kernel() {
+	static const KernelChoice choice = PickKernel();
+	return choice;
+}
+
+void CircleOverlapMasks(float cx, float cy, float cr,
+	const float* x, const float* y, const float* r, size_t count, uint8_t* masks) {
+	Kernel().fn(cx, cy, cr, x, y, r, count, masks);
+}
+
+const char* CircleKernelName() {
+	return Kernel().name;
+}
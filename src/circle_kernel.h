@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Batched circle-vs-circles overlap test.
+// Tests one circle (cx, cy, cr) against 'count' circles stored as packed
+// x/y/r arrays, 8 at a time. Bit i of masks[k] is set when circle 8k + i
+// overlaps, using exactly the same float math as Dist2 so results match the
+// scalar checks bit for bit. 'masks' needs room for (count + 7) / 8 bytes.
+//
+// The SIMD path is picked once at runtime: AVX2 when the CPU has it,
+// SSE2 on any other x86-64 machine, plain C++ everywhere else.
+void CircleOverlapMasks(float cx, float cy, float cr,
+	const float* x, const float* y, const float* r, size_t count, uint8_t* masks);
+
+// Reference version of the same test, one pair at a time
+void CircleOverlapMasksScalar(float cx, float cy, float cr,
+	const float* x, const float* y, const float* r, size_t count, uint8_t* masks);
+
+// "avx2", "sse2" or "scalar", whichever CircleOverlapMasks dispatches to
+const char* CircleKernelName();
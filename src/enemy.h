@@ -1,89 +1,108 @@
 #pragma once
-#include "olcPixelGameEngine.h"
+#include "circle_array.h"
 #include <random>
 
-struct Enemy {
-	olc::vf2d pos;
-	olc::vf2d vel;
-	float r = 30.0f;  // Bigger size for visibility
-	bool alive = true;
-	bool inArena = false;
-	olc::Decal* decal = nullptr;  // Added for sprite rendering
+struct Enemies : CircleArray {
+	std::vector<uint8_t> inArena;
 
-	void Update(float dt, int screenW, int screenH) {
-		if (!alive) return;
+	void Reserve(size_t cap) {
+		CircleArray::Reserve(cap, inArena);
+	}
+
+	int Add(const olc::vf2d& pos, const olc::vf2d& vel, float radius) {
+		int i = CircleArray::Add(pos, vel, radius);
+		if (i >= 0) inArena.push_back(0);
+		return i;
+	}
+
+	void Clear() {
+		CircleArray::Clear();
+		inArena.clear();
+	}
 
+	void RemoveDead() {
+		CircleArray::RemoveDead(inArena);
+	}
+
+	// 'rng' picks each enemy's roaming direction when it reaches the arena
+	void Update(float dt, int screenW, int screenH, std::mt19937& rng) {
 		float midY = screenH / 2.0f;
 
-		if (!inArena) {
-			// Coming down from top
-			pos += vel * dt;
-			if (pos.y >= midY) {
-				pos.y = midY;
-				inArena = true;
+		for (size_t i = 0; i < Size(); i++) {
+			if (!alive[i]) continue;
 
-				// Random roaming inside top half
-				olc::vf2d newVel = { 80.0f, 40.0f }; // default
-				// Small randomization using position as a fake "seed"
-				if (int(pos.x) % 2 == 0) newVel.x *= -1.0f;
-				if (int(pos.y) % 2 == 0) newVel.y *= -1.0f;
-				vel = newVel;
-			}
-		}
-		else {
-			// Roaming in the first half 
-			pos += vel * dt;
+			float& px = x[i];
+			float& py = y[i];
+			float& pvx = vx[i];
+			float& pvy = vy[i];
+			const float rad = r[i];
 
-			// Left-right wall bounce
-			if (pos.x - r < 0.0f) {
-				pos.x = r;
-				vel.x *= -1.0f;
-			}
-			if (pos.x + r > screenW) {
-				pos.x = screenW - r;
-				vel.x *= -1.0f;
-			}
+			if (!inArena[i]) {
+				// Coming down from top
+				px += pvx * dt;
+				py += pvy * dt;
+				if (py >= midY) {
+					py = midY;
+					inArena[i] = 1;
 
-			// Top-bottom bounce
-			if (pos.y - r < 0.0f) {
-				pos.y = r;
-				vel.y *= -1.0f;
+					// Random roaming inside top half
+					pvx = 80.0f; pvy = 40.0f; // default
+					// Raw engine bits rather than a distribution, whose output
+					// differs between standard libraries
+					uint32_t bits = uint32_t(rng());
+					if (bits & 1u) pvx *= -1.0f;
+					if (bits & 2u) pvy *= -1.0f;
+				}
 			}
-			if (pos.y + r > midY) {
-				pos.y = midY - r;
-				vel.y *= -1.0f;
+			else {
+				// Roaming in the first half 
+				px += pvx * dt;
+				py += pvy * dt;
+
+				// Left-right wall bounce
+				if (px - rad < 0.0f) {
+					px = rad;
+					pvx *= -1.0f;
+				}
+				if (px + rad > screenW) {
+					px = screenW - rad;
+					pvx *= -1.0f;
+				}
+
+				// Top-bottom bounce
+				if (py - rad < 0.0f) {
+					py = rad;
+					pvy *= -1.0f;
+				}
+				if (py + rad > midY) {
+					py = midY - rad;
+					pvy *= -1.0f;
+				}
 			}
-		}
 
-		// Safety: kill enemy if it goes out of bounds
-		if (pos.y - r > screenH + 80.0f) {
-			alive = false;
+			// Safety: kill enemy if it goes out of bounds
+			if (py - rad > screenH + 80.0f) {
+				alive[i] = 0;
+			}
 		}
 	}
 
-	void Draw(olc::PixelGameEngine* pge) {
-		if (!alive) return;
-
-		if (decal) {
-			// Make sprite height = 2 * r for consistent sizing
-			float desiredDiameter = r * 2.8f;
-			float sw = float(decal->sprite->width);
-			float sh = float(decal->sprite->height);
-			float scale = desiredDiameter / sh;
-
-			olc::vf2d vScale = { scale, scale };
-			olc::vf2d scaledSize = { sw * scale, sh * scale };
-			olc::vf2d drawPos = pos - scaledSize * 0.5f;
-
-			pge->DrawDecal(drawPos, decal, vScale);
+	void Draw(olc::PixelGameEngine* pge, SpriteBatch& batch, float alpha) {
+		if (sprite) {
+			// Make sprite height = 2.8 * r for consistent sizing
+			DrawScaled(batch, alpha, 2.8f, false);
 		}
 		else {
 			// Fallback triangle if no sprite loaded
-			auto p = pos;
-			olc::vf2d e1{ p.x - r, p.y - r };
-			olc::vf2d e2{ p.x + r, p.y - r };
-			olc::vf2d e3{ p.x,     p.y + r };
-			pge->FillTriangle(e1, e2, e3, olc::RED);
+			for (size_t i = 0; i < Size(); i++) {
+				if (!alive[i]) continue;
+				float rad = r[i];
+				auto p = DrawPos(i, alpha);
+				olc::vf2d e1{ p.x - rad, p.y - rad };
+				olc::vf2d e2{ p.x + rad, p.y - rad };
+				olc::vf2d e3{ p.x,       p.y + rad };
+				pge->FillTriangle(e1, e2, e3, olc::RED);
+			}
 		}
 	}
 };
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 #include "olcPixelGameEngine.h"
+#include "sprite_batch.h"
 #include <cmath>
 
 struct Boss {
 	olc::vf2d pos;
+	olc::vf2d prevPos; // start of the current tick, for render interpolation
 	olc::vf2d vel;
 	float r = 60.0f; // Bigger collision radius
 	int maxHp = 200;
@@ -11,10 +13,11 @@ struct Boss {
 	bool alive = false;
 	bool inArena = false;
 	float targetY = 100.0f; // Where the boss stops moving down
-	olc::Decal* decal = nullptr;  // Added for sprite rendering
+	SpriteRegion sprite;
 
 	void Reset(const olc::vf2d& startPos) {
 		pos = startPos;
+		prevPos = startPos;
 		hp = maxHp;
 		alive = true;
 		vel = { 0.0f, 70.0f }; // Move down
@@ -50,26 +53,26 @@ struct Boss {
 		}
 	}
 
-	void Draw(olc::PixelGameEngine* pge) {
+	void Draw(olc::PixelGameEngine* pge, SpriteBatch& batch, float alpha) {
 		if (!alive) return;
+		olc::vf2d drawPos = prevPos + (pos - prevPos) * alpha;
 
-		if (decal) {
+		if (sprite) {
 			// Make sprite height = 2 * r
 			float desiredDiameter = r * 2.0f;
-			float sw = float(decal->sprite->width);
-			float sh = float(decal->sprite->height);
+			float sw = sprite.size.x;
+			float sh = sprite.size.y;
 			float scale = desiredDiameter / sh;
 
 			olc::vf2d vScale = { scale, scale };
 			olc::vf2d scaledSize = { sw * scale, sh * scale };
-			olc::vf2d drawPos = pos - scaledSize * 0.5f;
-
-			pge->DrawDecal(drawPos, decal, vScale);
+			batch.Use(sprite);
+			batch.Add(drawPos - scaledSize * 0.5f, vScale);
 		}
 		else {
 			// Fallback geometric boss
-			int x = (int)pos.x;
-			int y = (int)pos.y;
+			int x = (int)drawPos.x;
+			int y = (int)drawPos.y;
 
 			// Body
 			pge->FillRect(x - 40, y - 12, 80, 24, olc::DARK_RED);
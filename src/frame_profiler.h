@@ -0,0 +1,128 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+#include "phase_timer.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+// Turns PhaseTimer's running totals into one sample per frame. The last
+// 'window' frames feed the on-screen overlay (rolling average and max);
+// with keepHistory set every frame is also kept for a CSV dump on exit.
+// Sampling is a few subtractions per phase, so it stays on all the time.
+struct FrameProfiler {
+	static constexpr int window = 120;
+
+	enum Counter { ASTEROIDS, BULLETS, ENEMIES, ENEMY_BULLETS, EXPLOSIONS, COUNTERS };
+
+	static const char* CounterName(int c) {
+		static const char* names[COUNTERS] = { "asteroids", "bullets", "enemies", "enemy_bullets", "explosions" };
+		return names[c];
+	}
+
+	struct Frame {
+		float frameMs = 0.0f;
+		float phaseMs[PhaseTimer::COUNT] = {};
+		uint32_t counts[COUNTERS] = {};
+	};
+
+	bool overlay = false;
+	bool keepHistory = false;
+	std::vector<Frame> history;
+
+	Frame ring[window];
+	int ringNext = 0;
+	int ringSize = 0;
+
+	// Timer totals at the end of the previous frame
+	double lastSeconds[PhaseTimer::COUNT] = {};
+
+	void EndFrame(const PhaseTimer& timer, float frameSeconds, const uint32_t counts[COUNTERS]) {
+		Frame f;
+		f.frameMs = frameSeconds * 1000.0f;
+		for (int p = 0; p < PhaseTimer::COUNT; p++) {
+			f.phaseMs[p] = float((timer.seconds[p] - lastSeconds[p]) * 1000.0);
+			lastSeconds[p] = timer.seconds[p];
+		}
+		std::copy(counts, counts + COUNTERS, f.counts);
+
+		ring[ringNext] = f;
+		ringNext = (ringNext + 1) % window;
+		ringSize = std::min(ringSize + 1, window);
+
+		if (keepHistory) history.push_back(f);
+	}
+
+	// Average and worst frame of the rolling window
+	void Summarize(Frame& avg, Frame& max) const {
+		avg = Frame();
+		max = Frame();
+		for (int i = 0; i < ringSize; i++) {
+			const Frame& f = ring[i];
+			avg.frameMs += f.frameMs;
+			max.frameMs = std::max(max.frameMs, f.frameMs);
+			for (int p = 0; p < PhaseTimer::COUNT; p++) {
+				avg.phaseMs[p] += f.phaseMs[p];
+				max.phaseMs[p] = std::max(max.phaseMs[p], f.phaseMs[p]);
+			}
+		}
+		if (ringSize == 0) return;
+
+		avg.frameMs /= ringSize;
+		for (int p = 0; p < PhaseTimer::COUNT; p++) avg.phaseMs[p] /= ringSize;
+
+		const Frame& latest = ring[(ringNext + window - 1) % window];
+		std::copy(latest.counts, latest.counts + COUNTERS, avg.counts);
+	}
+
+	void DrawOverlay(olc::PixelGameEngine* pge, int x, int y) const {
+		Frame avg, max;
+		Summarize(avg, max);
+
+		const int lineH = 10;
+		const int lines = 3 + PhaseTimer::COUNT + COUNTERS;
+		pge->FillRect(x, y, 250, lines * lineH + 8, olc::Pixel(0, 0, 0, 220));
+		pge->DrawRect(x, y, 250, lines * lineH + 8, olc::WHITE);
+
+		char text[64];
+		int ty = y + 4;
+		std::snprintf(text, sizeof(text), "frame %6.2f ms  max %6.2f", avg.frameMs, max.frameMs);
+		pge->DrawString(x + 4, ty, text, olc::YELLOW);
+		ty += lineH * 2;
+
+		pge->DrawString(x + 4, ty, "phase              avg     max", olc::CYAN);
+		ty += lineH;
+		for (int p = 0; p < PhaseTimer::COUNT; p++) {
+			std::snprintf(text, sizeof(text), "%-17s %6.3f  %6.3f", PhaseTimer::Name(p), avg.phaseMs[p], max.phaseMs[p]);
+			pge->DrawString(x + 4, ty, text, olc::WHITE);
+			ty += lineH;
+		}
+
+		for (int c = 0; c < COUNTERS; c++) {
+			std::snprintf(text, sizeof(text), "%-17s %6u", CounterName(c), avg.counts[c]);
+			pge->DrawString(x + 4, ty, text, olc::GREEN);
+			ty += lineH;
+		}
+	}
+
+	bool WriteCsv(const std::string& path) const {
+		std::ofstream out(path);
+		if (!out) return false;
+
+		out << "frame,frame_ms";
+		for (int p = 0; p < PhaseTimer::COUNT; p++) out << "," << PhaseTimer::Name(p) << "_ms";
+		for (int c = 0; c < COUNTERS; c++) out << "," << CounterName(c);
+		out << "\n";
+
+		for (size_t i = 0; i < history.size(); i++) {
+			const Frame& f = history[i];
+			out << i << "," << f.frameMs;
+			for (int p = 0; p < PhaseTimer::COUNT; p++) out << "," << f.phaseMs[p];
+			for (int c = 0; c < COUNTERS; c++) out << "," << f.counts[c];
+			out << "\n";
+		}
+		return bool(out);
+	}
+};
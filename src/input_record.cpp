@@ -0,0 +1,148 @@
+#include "input_record.h"
+#include <fstream>
+#include <cstring>
+#include <cmath>
+
+InputState InputState::Capture(olc::PixelGameEngine* pge) {
+	struct Mapping { olc::Key key; uint16_t held; uint16_t pressed; };
+	static const Mapping mappings[] = {
+		{ olc::Key::LEFT,   InputBit::LEFT,  0 },
+		{ olc::Key::RIGHT,  InputBit::RIGHT, 0 },
+		{ olc::Key::UP,     InputBit::UP,    InputBit::PRESSED_UP },
+		{ olc::Key::DOWN,   InputBit::DOWN,  InputBit::PRESSED_DOWN },
+		{ olc::Key::A,      InputBit::A,     0 },
+		{ olc::Key::D,      InputBit::D,     0 },
+		{ olc::Key::W,      InputBit::W,     InputBit::PRESSED_W },
+		{ olc::Key::S,      InputBit::S,     InputBit::PRESSED_S },
+		{ olc::Key::ENTER,  0,               InputBit::PRESSED_ENTER },
+		{ olc::Key::ESCAPE, 0,               InputBit::PRESSED_ESCAPE },
+	};
+
+	InputState state;
+	for (const Mapping& m : mappings) {
+		olc::HWButton b = pge->GetKey(m.key);
+		if (b.bHeld) state.bits |= m.held;
+		if (b.bPressed) state.bits |= m.pressed;
+	}
+	return state;
+}
+
+// Everything on disk is little-endian, whatever the host is
+static void PutU16(std::vector<uint8_t>& out, uint16_t v) {
+	out.push_back(uint8_t(v));
+	out.push_back(uint8_t(v >> 8));
+}
+
+static void PutU32(std::vector<uint8_t>& out, uint32_t v) {
+	for (int i = 0; i < 4; i++) out.push_back(uint8_t(v >> (i * 8)));
+}
+
+static void PutVarint(std::vector<uint8_t>& out, uint32_t v) {
+	while (v >= 0x80) {
+		out.push_back(uint8_t(v | 0x80));
+		v >>= 7;
+	}
+	out.push_back(uint8_t(v));
+}
+
+struct Reader {
+	const std::vector<uint8_t>& data;
+	size_t at = 0;
+	bool ok = true;
+
+	uint8_t Byte() {
+		if (at >= data.size()) { ok = false; return 0; }
+		return data[at++];
+	}
+
+	uint16_t U16() {
+		uint16_t lo = Byte();
+		return uint16_t(lo | (uint16_t(Byte()) << 8));
+	}
+
+	uint32_t U32() {
+		uint32_t v = 0;
+		for (int i = 0; i < 4; i++) v |= uint32_t(Byte()) << (i * 8);
+		return v;
+	}
+
+	uint32_t Varint() {
+		uint32_t v = 0;
+		for (int shift = 0; shift < 35; shift += 7) {
+			uint8_t b = Byte();
+			v |= uint32_t(b & 0x7F) << shift;
+			if (!(b & 0x80)) return v;
+		}
+		ok = false;
+		return 0;
+	}
+};
+
+bool InputRecording::Save(const std::string& path) const {
+	std::vector<uint8_t> out;
+	PutU32(out, magic);
+	PutU16(out, version);
+	PutU32(out, seed);
+	PutU32(out, buildHash);
+
+	uint32_t rateBits;
+	std::memcpy(&rateBits, &tickRate, sizeof(rateBits));
+	PutU32(out, rateBits);
+	PutU32(out, uint32_t(ticks.size()));
+
+	for (size_t i = 0; i < ticks.size();) {
+		size_t run = 1;
+		while (i + run < ticks.size() && ticks[i + run].bits == ticks[i].bits) run++;
+
+		PutU16(out, ticks[i].bits);
+		PutVarint(out, uint32_t(run));
+		i += run;
+	}
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file) return false;
+	file.write(reinterpret_cast<const char*>(out.data()), std::streamsize(out.size()));
+	return bool(file);
+}
+
+bool InputRecording::Load(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) return false;
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	Reader in{ data };
+	if (in.U32() != magic || in.U16() != version) return false;
+
+	seed = in.U32();
+	buildHash = in.U32();
+	uint32_t rateBits = in.U32();
+	std::memcpy(&tickRate, &rateBits, sizeof(tickRate));
+	uint32_t count = in.U32();
+	if (!in.ok) return false;
+
+	// The game steps 1 / tickRate per tick; zero, NaN or a silly rate would
+	// stall or spin its accumulator
+	if (!std::isfinite(tickRate) || tickRate < minTickRate || tickRate > maxTickRate) return false;
+
+	// The count comes from the file, so it is only trusted as far as the
+	// runs behind it: ticks grows run by run, and a count no real session
+	// reaches is rejected before anything is allocated for it
+	if (count > maxTicks) return false;
+
+	ticks.clear();
+	while (ticks.size() < count) {
+		InputState state{ in.U16() };
+		uint32_t run = in.Varint();
+		if (!in.ok || run == 0 || run > count - ticks.size()) return false;
+		ticks.insert(ticks.end(), run, state);
+	}
+	return true;
+}
+
+uint32_t BuildHash() {
+#if defined(STARFALL_BUILD_HASH)
+	return uint32_t(STARFALL_BUILD_HASH);
+#else
+	return 0;
+#endif
+}
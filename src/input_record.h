@@ -0,0 +1,66 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// The keys the game reads each tick, packed into one 16-bit word.
+// Held bits cover movement and menu keys; the pressed bits are the
+// edge-triggered reads the menus and pause toggle rely on.
+namespace InputBit {
+	enum : uint16_t {
+		LEFT  = 1 << 0,
+		RIGHT = 1 << 1,
+		UP    = 1 << 2,
+		DOWN  = 1 << 3,
+		A     = 1 << 4,
+		D     = 1 << 5,
+		W     = 1 << 6,
+		S     = 1 << 7,
+
+		PRESSED_UP     = 1 << 8,
+		PRESSED_DOWN   = 1 << 9,
+		PRESSED_W      = 1 << 10,
+		PRESSED_S      = 1 << 11,
+		PRESSED_ENTER  = 1 << 12,
+		PRESSED_ESCAPE = 1 << 13,
+	};
+}
+
+struct InputState {
+	uint16_t bits = 0;
+
+	bool Has(uint16_t bit) const { return (bits & bit) != 0; }
+
+	// Reads the live keyboard into a packed word
+	static InputState Capture(olc::PixelGameEngine* pge);
+};
+
+// A recorded session: header plus one InputState per tick.
+// On disk the ticks are run-length encoded as (state, varint run length)
+// pairs, so long stretches of the same keys cost three or four bytes.
+struct InputRecording {
+	static constexpr uint32_t magic = 0x50525353; // "SSRP"
+	static constexpr uint16_t version = 1;
+
+	// Tick rates Load accepts, in ticks a second
+	static constexpr float minTickRate = 1.0f;
+	static constexpr float maxTickRate = 1000.0f;
+
+	// A day of play at the fastest tick rate; a longer file is corrupt
+	static constexpr uint32_t maxTicks = uint32_t(maxTickRate) * 60 * 60 * 24;
+
+	uint32_t seed = 0;
+	uint32_t buildHash = 0;
+	float tickRate = 0.0f;
+	std::vector<InputState> ticks;
+
+	bool Save(const std::string& path) const;
+	bool Load(const std::string& path);
+};
+
+// Identifies the commit the executable was built from, so a replay can tell
+// whether the simulation may have changed since it was recorded. The project
+// file and the documented g++ lines pass -DSTARFALL_BUILD_HASH=0x<git hash
+// prefix>; uncommitted edits don't change it. 0 when the build set no hash.
+uint32_t BuildHash();
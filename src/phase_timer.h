@@ -0,0 +1,70 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+// Lap-style timer for the stages of a gameplay tick. Start(p) charges the
+// time since the previous Start() to whichever phase was running, so the
+// game only marks boundaries instead of wrapping every stage in a scope.
+// Does nothing until 'enabled' is set.
+struct PhaseTimer {
+	enum Phase {
+		// Simulation tick
+		SPAWN, UPDATE, BROADPHASE,
+		HIT_ASTEROIDS, HIT_ENEMIES, HIT_PLAYER_ASTEROID, HIT_PLAYER_ENEMY, HIT_PLAYER_BULLET, HIT_BOSS,
+		CLEANUP,
+		// Frame drawing
+		DRAW_ENTITIES, DRAW_EXPLOSIONS, DRAW_HUD,
+		// Offline sound backend catching the mix up with game time
+		AUDIO_MIX,
+		COUNT
+	};
+
+	static const char* Name(int phase) {
+		static const char* names[COUNT] = {
+			"spawn", "update", "broadphase",
+			"hit_asteroids", "hit_enemies", "hit_player_ast", "hit_player_enemy", "hit_player_bullet", "hit_boss",
+			"cleanup",
+			"draw_entities", "draw_explosions", "draw_hud",
+			"audio_mix",
+		};
+		return names[phase];
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	bool enabled = false;
+	double seconds[COUNT] = {};
+	uint64_t laps[COUNT] = {};
+
+	int current = -1;
+	Clock::time_point started;
+
+	void Start(int phase) {
+		if (!enabled) return;
+		Clock::time_point now = Clock::now();
+		Charge(now);
+		current = phase;
+		started = now;
+	}
+
+	void Stop() {
+		if (!enabled) return;
+		Charge(Clock::now());
+		current = -1;
+	}
+
+	void Reset() {
+		for (int p = 0; p < COUNT; p++) {
+			seconds[p] = 0.0;
+			laps[p] = 0;
+		}
+		current = -1;
+	}
+
+private:
+	void Charge(Clock::time_point now) {
+		if (current < 0) return;
+		seconds[current] += std::chrono::duration<double>(now - started).count();
+		laps[current]++;
+	}
+};
@@ -1,17 +1,20 @@
 #pragma once
 #include "olcPixelGameEngine.h"
+#include "input_record.h"
+#include "sprite_batch.h"
 
 struct Player {
 	olc::vf2d pos;
+	olc::vf2d prevPos; // start of the current tick, for render interpolation
 	float speed = 180.0f;
 	float r = 30.0f;
 	int lives = 3;
 
 	float invincibleTimer = 0.0f; // for flicker
 
-	olc::Decal* decal = nullptr;
+	SpriteRegion sprite;
 
 	void Reset(const olc::vf2d& startPos);
-	void Update(olc::PixelGameEngine* pge, float dt);
-	void Draw(olc::PixelGameEngine* pge);
+	void Update(const InputState& input, float dt, int screenW, int screenH);
+	void Draw(olc::PixelGameEngine* pge, SpriteBatch& batch, float alpha);
 };
\ No newline at end of file
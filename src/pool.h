@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+
+// Pool for small array-of-structs entities, with the same contract as
+// CircleArray: Reserve() up front, an Acquire() past the capacity grows the
+// pool and counts an overflow, and removal keeps the survivors in order.
+template<typename T>
+struct Pool {
+	std::vector<T> items;
+	size_t capacity = 0;
+	size_t highWater = 0;
+	size_t overflows = 0;
+
+	size_t Size() const { return items.size(); }
+
+	auto begin() { return items.begin(); }
+	auto end() { return items.end(); }
+	auto begin() const { return items.begin(); }
+	auto end() const { return items.end(); }
+
+	void Reserve(size_t cap) {
+		capacity = cap;
+		highWater = Size();
+		overflows = 0;
+		items.reserve(cap);
+	}
+
+	// Returns a default-initialised slot
+	T* Acquire() {
+		if (Size() >= capacity) overflows++;
+		items.emplace_back();
+		highWater = std::max(highWater, Size());
+		return &items.back();
+	}
+
+	template<typename F>
+	void RemoveIf(F&& dead) {
+		items.erase(std::remove_if(items.begin(), items.end(), dead), items.end());
+	}
+
+	void Clear() { items.clear(); }
+};
\ No newline at end of file
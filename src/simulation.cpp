@@ -0,0 +1,442 @@
+#include "simulation.h"
+#include <algorithm>
+
+const PoolSizes levelPools[4] = {
+	{  0,  0, 0,  0,  0 }, // unused
+	{ 48, 32, 8, 16, 48 }, // asteroids every 0.5s
+	{ 32, 32, 8, 48, 48 }, // + up to 5 enemies firing
+	{ 32, 32, 8, 64, 48 }, // + boss double shots
+};
+
+void Simulation::Init(int screenW, int screenH, uint32_t seed) {
+	width = screenW;
+	height = screenH;
+	Seed(seed);
+
+	asteroidGrid.Resize(float(width), float(height), 64.0f);
+	enemyGrid.Resize(float(width), float(height), 64.0f);
+	bulletGrid.Resize(float(width), float(height), 64.0f);
+	enemyBulletGrid.Resize(float(width), float(height), 64.0f);
+
+	// A tick raises a handful of events at most
+	events.reserve(64);
+}
+
+void Simulation::ResetGame() {
+	score = 0;
+	hits = 0;
+	player.lives = 3;
+	enemiesKilled = 0;
+	total_enemy_spawn = 0;
+
+	asteroids.Clear();
+	bullets.Clear();
+	enemies.Clear();
+	enemyBullets.Clear();
+
+	enemySpawnTimer = 0.0f;
+	enemyFireTimer = 0.0f;
+	bossFireTimer = 0.0f;
+
+	boss.hp = boss.maxHp;
+	wins = false;
+	boss.alive = false;
+	isTransitioning = false;
+}
+
+void Simulation::StartLevel(int lvl) {
+	currentLevel = lvl;
+	levelTime = 0.0f;
+	spawnTimer = 0.0f;
+	enemySpawnTimer = 0.0f;
+	enemyFireTimer = 0.0f;
+	enemiesKilled = 0;
+	total_enemy_spawn = 0;
+
+	bullets.Clear();
+	asteroids.Clear();
+	enemies.Clear();
+	enemyBullets.Clear();
+
+	// Size the pools for this level; gameplay ticks don't allocate after this
+	// unless a pool overflows, which the report at the next level shows
+	const PoolSizes& pools = levelPools[currentLevel];
+	asteroids.Reserve(pools.asteroids);
+	bullets.Reserve(pools.bullets);
+	enemies.Reserve(pools.enemies);
+	enemyBullets.Reserve(pools.enemyBullets);
+	explosions.Reserve(pools.explosions);
+	hitScratch.reserve(pools.asteroids + pools.enemies + pools.enemyBullets);
+	pooledLevel = currentLevel;
+
+	if (currentLevel == 1) {
+		spawnRate = 0.5f;
+	}
+	else if (currentLevel == 2) {
+		spawnRate = 0.7f;
+		enemySpawnRate = 2.0f;
+	}
+	else if (currentLevel == 3) {
+		spawnRate = 0.9f;
+		enemySpawnRate = 2.5f;
+
+		boss.Reset({ width / 2.0f, -60.0f });
+
+		bossFireCooldown = 1.2f;
+		bossFireTimer = 1.0f;
+	}
+
+	player.Reset({ width / 2.0f, height - 60.0f });
+}
+
+LevelResult Simulation::Tick(float dt, const InputState& input) {
+	// Interpolation starts from wherever everything is before this tick
+	player.prevPos = player.pos;
+	boss.prevPos = boss.pos;
+	asteroids.SavePrevious();
+	enemies.SavePrevious();
+	bullets.SavePrevious();
+	enemyBullets.SavePrevious();
+
+	// Transition Freeze
+	if (isTransitioning)
+		transitionTimer -= dt;
+	else
+		Step(dt, input);
+
+	return CheckLevelEnd();
+}
+
+void Simulation::Step(float dt, const InputState& input) {
+	levelTime += dt;
+
+	phases.Start(PhaseTimer::UPDATE);
+
+	// Player update
+	player.Update(input, dt, width, height);
+
+	phases.Start(PhaseTimer::SPAWN);
+
+	// Auto-shooting
+	fireTimer -= dt;
+	if (fireTimer <= 0.0f) {
+		olc::vf2d spawnPos = player.pos + olc::vf2d{ 0.0, -player.r };
+		SpawnBullet(spawnPos);
+		events.push_back(SimEvent::SHOOT);
+		fireTimer = fireCoolDown;
+	}
+
+	// Spawn asteroids
+	spawnTimer -= dt;
+	if (spawnTimer <= 0.0f) {
+		SpawnAsteroid();
+		spawnTimer = spawnRate;
+	}
+
+	// Spawn enemies (Level 2 and 3)
+	if (currentLevel == 2 || currentLevel == 3) {
+		enemySpawnTimer -= dt;
+		if (enemySpawnTimer <= 0.0f) {
+			int aliveEnemies = 0;
+			for (size_t i = 0; i < enemies.Size(); i++) {
+				if (enemies.alive[i]) aliveEnemies++;
+			}
+
+			bool canSpawn = true;
+			if (currentLevel == 2 && total_enemy_spawn >= level2KillTarget)
+				canSpawn = false;
+
+			if (canSpawn && aliveEnemies < maxEnemies) {
+				total_enemy_spawn++;
+				SpawnEnemy();
+			}
+			enemySpawnTimer = enemySpawnRate;
+		}
+	}
+
+	phases.Start(PhaseTimer::UPDATE);
+	bullets.Update(dt);
+	asteroids.Update(dt, height);
+	enemies.Update(dt, width, height, rng);
+
+	// Enemy shooting
+	if (currentLevel == 2 || currentLevel == 3) {
+		enemyFireTimer -= dt;
+		if (enemyFireTimer <= 0.0f) {
+			for (size_t i = 0; i < enemies.Size(); i++) {
+				if (!enemies.alive[i]) continue;
+				olc::vf2d muz = enemies.Pos(i) + olc::vf2d{ 0.0f, enemies.r[i] };
+				SpawnEnemyBullet(muz);
+			}
+			enemyFireTimer = enemyFireCooldown;
+		}
+	}
+
+	enemyBullets.Update(dt, height);
+
+	// Boss update and shooting
+	if (currentLevel == 3 && boss.alive) {
+		boss.Update(dt, width);
+
+		bossFireTimer -= dt;
+		if (bossFireTimer <= 0.0f) {
+			SpawnBossBullets();
+			bossFireTimer = bossFireCooldown;
+		}
+	}
+
+	for (auto& exp : explosions) {
+		exp.timer -= dt;
+	}
+
+	// ===== COLLISION DETECTION =====
+	phases.Start(PhaseTimer::BROADPHASE);
+
+	// Entities don't move during the passes, so one rebuild serves them all
+	BuildGrid(asteroidGrid, asteroids);
+	BuildGrid(enemyGrid, enemies);
+	BuildGrid(bulletGrid, bullets);
+	BuildGrid(enemyBulletGrid, enemyBullets);
+
+	// Asteroid vs bullets
+	phases.Start(PhaseTimer::HIT_ASTEROIDS);
+	for (size_t b = 0; b < bullets.Size(); b++) {
+		if (!bullets.alive[b]) continue;
+		int a = FirstHit(asteroidGrid, asteroids, bullets.Pos(b), bullets.r[b]);
+		if (a < 0) continue;
+
+		bullets.alive[b] = 0;
+		SpawnExplosion(asteroids.Pos(a), ExplosionKind::ASTEROID, 0.25f, asteroids.r[a] * 2.0f);
+		asteroids.alive[a] = 0;
+		score += 5;
+	}
+
+	// Enemy vs bullets
+	phases.Start(PhaseTimer::HIT_ENEMIES);
+	for (size_t b = 0; b < bullets.Size(); b++) {
+		if (!bullets.alive[b]) continue;
+		int e = FirstHit(enemyGrid, enemies, bullets.Pos(b), bullets.r[b]);
+		if (e < 0) continue;
+
+		bullets.alive[b] = 0;
+		enemies.alive[e] = 0;
+		SpawnExplosion(enemies.Pos(e), ExplosionKind::SHIP, 0.35f, enemies.r[e] * 2.0f);
+		score += 10;
+		enemiesKilled += 1;
+	}
+
+	// Asteroid vs player
+	phases.Start(PhaseTimer::HIT_PLAYER_ASTEROID);
+	for (uint32_t a : AllHits(asteroidGrid, asteroids, player.pos, player.r)) {
+		asteroids.alive[a] = 0;
+		SpawnExplosion(asteroids.Pos(a), ExplosionKind::ASTEROID, 0.25f, asteroids.r[a] * 2.0f);
+		if (player.invincibleTimer <= 0.0f)
+			HitPlayer(player.pos, player.r * 2.0f);
+	}
+
+	// Enemy vs player
+	phases.Start(PhaseTimer::HIT_PLAYER_ENEMY);
+	for (uint32_t e : AllHits(enemyGrid, enemies, player.pos, player.r)) {
+		enemies.alive[e] = 0;
+		SpawnExplosion(enemies.Pos(e), ExplosionKind::SHIP, 0.35f, enemies.r[e] * 2.0f);
+		if (player.invincibleTimer <= 0.0f)
+			HitPlayer(player.pos, enemies.r[e] * 2.0f);
+	}
+
+	// Enemy bullets vs player
+	phases.Start(PhaseTimer::HIT_PLAYER_BULLET);
+	for (uint32_t eb : AllHits(enemyBulletGrid, enemyBullets, player.pos, player.r)) {
+		enemyBullets.alive[eb] = 0;
+		if (player.invincibleTimer <= 0.0f)
+			HitPlayer(player.pos, player.r * 2.0f);
+	}
+
+	// Player bullets vs boss
+	phases.Start(PhaseTimer::HIT_BOSS);
+	if (currentLevel == 3 && boss.alive) {
+		int b = FirstHit(bulletGrid, bullets, boss.pos, boss.r);
+		if (b >= 0) {
+			bullets.alive[b] = 0;
+			boss.hp -= 5;
+			score += 25;
+
+			if (boss.hp <= 0) {
+				boss.hp = 0;
+				boss.alive = false;
+				SpawnExplosion(boss.pos, ExplosionKind::SHIP, 0.35f, boss.r * 2.0f);
+
+				if (!isTransitioning) {
+					isTransitioning = true;
+					transitionTimer = 2.0f;
+					wins = true;
+				}
+			}
+		}
+	}
+
+	// Boss vs player
+	if (currentLevel == 3 && boss.alive) {
+		float hitR = boss.r + player.r;
+		if (Dist2(boss.pos, player.pos) <= hitR * hitR && player.invincibleTimer <= 0.0f)
+			HitPlayer(boss.pos, boss.r * 2.0f);
+	}
+
+	// Clean up dead objects
+	phases.Start(PhaseTimer::CLEANUP);
+	bullets.RemoveDead();
+	asteroids.RemoveDead();
+	enemies.RemoveDead();
+	enemyBullets.RemoveDead();
+	explosions.RemoveIf([](const Explosion& exp) {return exp.timer <= 0.0f; });
+	phases.Stop();
+}
+
+void Simulation::HitPlayer(const olc::vf2d& deathPos, float deathSize) {
+	hits++;
+	player.lives--;
+	player.invincibleTimer = 2.0f;
+	events.push_back(SimEvent::PLAYER_HIT);
+
+	if (player.lives <= 0) {
+		SpawnExplosion(deathPos, ExplosionKind::SHIP, 0.35f, deathSize);
+		events.push_back(SimEvent::GAME_OVER);
+
+		if (!isTransitioning) {
+			isTransitioning = true;
+			transitionTimer = 2.0f;
+			wins = false;
+		}
+	}
+}
+
+LevelResult Simulation::CheckLevelEnd() {
+	bool done;
+	if (player.lives <= 0)
+		done = true;
+	else if (currentLevel == 1)
+		done = levelTime >= level1Duration;
+	else if (currentLevel == 2)
+		done = enemiesKilled >= level2KillTarget;
+	else
+		done = !boss.alive && wins;
+
+	if (!done) return LevelResult::PLAYING;
+
+	// First tick of the end: start the pause. Deaths started it already.
+	if (!isTransitioning) {
+		isTransitioning = true;
+		transitionTimer = 2.0f;
+		if (player.lives <= 0) {
+			wins = false;
+			events.push_back(SimEvent::GAME_OVER);
+		}
+		else {
+			events.push_back(SimEvent::LEVEL_COMPLETE);
+		}
+		return LevelResult::PLAYING;
+	}
+
+	if (transitionTimer > 0.0f) return LevelResult::PLAYING;
+
+	isTransitioning = false;
+	if (player.lives <= 0) return LevelResult::LOST;
+	return currentLevel == 3 ? LevelResult::WON : LevelResult::CLEARED;
+}
+
+void Simulation::SpawnEnemy() {
+	std::uniform_real_distribution<float> xDist(40.0f, float(width - 40.0f));
+	std::uniform_real_distribution<float> vyDist(80.0f, 130.0f);
+	std::uniform_real_distribution<float> vxDist(-40.0f, 40.0f);
+
+	olc::vf2d pos = { xDist(rng), -40.0f };
+	olc::vf2d vel = { vxDist(rng), vyDist(rng) };
+	enemies.Add(pos, vel, 20.0f);
+}
+
+void Simulation::SpawnAsteroid() {
+	std::uniform_real_distribution<float> xDist(10.0f, float(width) - 10.0f);
+	std::uniform_real_distribution<float> vyDist(80.0f, 150.0f);
+	std::uniform_real_distribution<float> vxDist(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> rDist(24.0f, 40.0f);
+
+	olc::vf2d pos = { xDist(rng), -30.0f };
+	olc::vf2d vel = { vxDist(rng), vyDist(rng) };
+	float r = rDist(rng);
+	asteroids.Add(pos, vel, r);
+}
+
+void Simulation::SpawnBullet(const olc::vf2d& startPos) {
+	bullets.Add(startPos, { 0.0f, -350.0f }, 4.0f);
+}
+
+void Simulation::SpawnEnemyBullet(const olc::vf2d& startPos) {
+	enemyBullets.Add(startPos, { 0.0f, 220.0f }, 4.0f);
+}
+
+void Simulation::SpawnBossBullets() {
+	if (!boss.alive) return;
+
+	olc::vf2d leftmuzz = boss.pos + olc::vf2d{ -30.0f, boss.r * 0.5f };
+	olc::vf2d rightmuzz = boss.pos + olc::vf2d{ 30.0f, boss.r * 0.5f };
+
+	enemyBullets.Add(leftmuzz, { 0.0f, 260.0f }, 4.0f);
+	enemyBullets.Add(rightmuzz, { 0.0f, 260.0f }, 4.0f);
+}
+
+void Simulation::SpawnExplosion(const olc::vf2d& pos, ExplosionKind kind, float maxTime, float size) {
+	events.push_back(SimEvent::EXPLOSION);
+
+	Explosion* e = explosions.Acquire();
+	e->pos = pos;
+	e->kind = kind;
+	e->maxTime = maxTime;
+	e->timer = maxTime;
+	e->size = size;
+}
+
+void Simulation::ReportPoolUsage(std::ostream& out) const {
+	out << "Level " << pooledLevel << " pool high-water:"
+		<< " asteroids " << asteroids.highWater << "/" << asteroids.capacity
+		<< ", bullets " << bullets.highWater << "/" << bullets.capacity
+		<< ", enemies " << enemies.highWater << "/" << enemies.capacity
+		<< ", enemy bullets " << enemyBullets.highWater << "/" << enemyBullets.capacity
+		<< ", explosions " << explosions.highWater << "/" << explosions.capacity
+		<< std::endl;
+
+	// Spawns past a capacity still happen but allocate; raise levelPools
+	size_t overflows = asteroids.overflows + bullets.overflows + enemies.overflows
+		+ enemyBullets.overflows + explosions.overflows;
+	if (overflows > 0)
+		out << "Level " << pooledLevel << " pools overflowed " << overflows
+			<< " times; raise levelPools so gameplay stops allocating" << std::endl;
+}
+
+void Simulation::BuildGrid(SpatialGrid& grid, const CircleArray& v) {
+	grid.Begin();
+	for (uint32_t n = 0; n < v.Size(); n++) {
+		if (v.alive[n]) grid.Add(n, v.x[n], v.y[n], v.r[n]);
+	}
+	grid.End();
+}
+
+// Lowest index alive entity overlapping the circle, or -1. Pools keep
+// spawn order, so that is the oldest one, as with the old in-order scan
+// that stopped at the first hit.
+// The grid runs the same Dist2 test as the batched SIMD kernel.
+int Simulation::FirstHit(const SpatialGrid& grid, const CircleArray& v, const olc::vf2d& pos, float r) const {
+	int hit = -1;
+	grid.QueryOverlaps(pos.x, pos.y, r, [&](uint32_t n) {
+		if (v.alive[n] && (hit < 0 || int(n) < hit)) hit = int(n);
+	});
+	return hit;
+}
+
+// Every alive entity overlapping the circle, in ascending index order
+std::vector<uint32_t>& Simulation::AllHits(const SpatialGrid& grid, const CircleArray& v, const olc::vf2d& pos, float r) {
+	hitScratch.clear();
+	grid.QueryOverlaps(pos.x, pos.y, r, [&](uint32_t n) {
+		if (v.alive[n]) hitScratch.push_back(n);
+	});
+	std::sort(hitScratch.begin(), hitScratch.end());
+	return hitScratch;
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+
+#include "player.h"
+#include "asteroid.h"
+#include "bullet.h"
+#include "enemy.h"
+#include "enemy_bullet.h"
+#include "enemy_boss.h"
+#include "spatial_grid.h"
+#include "pool.h"
+#include "input_record.h"
+#include "phase_timer.h"
+
+#include <vector>
+#include <random>
+#include <ostream>
+
+inline float Dist2(const olc::vf2d& a, const olc::vf2d& b) {
+	olc::vf2d d = a - b;
+	return d.x * d.x + d.y * d.y;
+}
+
+enum class ExplosionKind : uint8_t { ASTEROID, SHIP };
+
+struct Explosion {
+	olc::vf2d pos;
+	ExplosionKind kind = ExplosionKind::ASTEROID;
+	float timer = 0.0f;
+	float maxTime = 0.25f; // Explosion visible for 0.25 seconds
+	float size = 0.0f;     // On-screen width in pixels
+};
+
+// Things the presentation layer reacts to, mostly with a sound
+enum class SimEvent : uint8_t {
+	SHOOT,
+	EXPLOSION,
+	PLAYER_HIT,
+	GAME_OVER,
+	LEVEL_COMPLETE,
+};
+
+// What Tick() reports once a level's end-of-level pause has run out
+enum class LevelResult : uint8_t {
+	PLAYING,
+	CLEARED, // level 1 or 2 done, on to the next
+	WON,     // boss destroyed
+	LOST,    // out of lives
+};
+
+// Comfortably above what the spawn timers can keep alive at once; the
+// high-water marks printed at the end of each level show the headroom.
+// A spawn past a capacity is never dropped: the pool grows and the report
+// counts the overflow.
+struct PoolSizes {
+	size_t asteroids;
+	size_t bullets;
+	size_t enemies;
+	size_t enemyBullets;
+	size_t explosions;
+};
+
+extern const PoolSizes levelPools[4];
+
+// One play session's gameplay: entities, timers, score and level.
+// Owns no engine, window, sound or global state, so any number of
+// sessions can run side by side on different threads. The game drives
+// one through Tick() and turns its events into sounds; the entity
+// containers carry sprite regions only for the game to draw with.
+class Simulation {
+public:
+	// Playfield size
+	int width = 900;
+	int height = 600;
+
+	Player player;
+	Asteroids asteroids;
+	Bullets bullets;
+	Enemies enemies;
+	Boss boss;
+	EnemyBullets enemyBullets;
+	Pool<Explosion> explosions;
+	int pooledLevel = 0;
+
+	std::mt19937 rng;
+
+	// Timer & Level
+	int currentLevel = 0;
+	float levelTime = 0.0f;
+	const float level1Duration = 25.0f;
+
+	// Stats
+	int score = 0;
+	int hits = 0;
+	bool wins = false;
+	int enemiesKilled = 0;
+	int level2KillTarget = 25;
+	int total_enemy_spawn = 0;
+
+	// End-of-level pause: gameplay freezes for transitionTimer seconds
+	float transitionTimer = 0.0f;
+	bool isTransitioning = false;
+
+	// Filled by Tick(), cleared by whoever consumes them
+	std::vector<SimEvent> events;
+
+	// Per-stage timings, off unless someone enables them
+	PhaseTimer phases;
+
+	void Init(int screenW, int screenH, uint32_t seed);
+	void Seed(uint32_t seed) { rng.seed(seed); }
+
+	// Back to a fresh session: full lives, no score
+	void ResetGame();
+	void StartLevel(int lvl);
+
+	// Advances one fixed step
+	LevelResult Tick(float dt, const InputState& input);
+
+	void ReportPoolUsage(std::ostream& out) const;
+
+private:
+	// Spawning timers
+	float spawnTimer = 0.0f;
+	float spawnRate = 0.1f;
+	float fireCoolDown = 0.30f;
+	float fireTimer = 0.0f;
+	float enemySpawnTimer = 0.0f;
+	float enemySpawnRate = 2.0f;
+	int maxEnemies = 5;
+	float enemyFireTimer = 0.0f;
+	float enemyFireCooldown = 1.5f;
+	float bossFireTimer = 0.0f;
+	float bossFireCooldown = 1.0f;
+
+	// Broadphase, rebuilt once per tick before the collision passes
+	SpatialGrid asteroidGrid;
+	SpatialGrid enemyGrid;
+	SpatialGrid bulletGrid;
+	SpatialGrid enemyBulletGrid;
+	std::vector<uint32_t> hitScratch;
+
+	void Step(float dt, const InputState& input);
+	LevelResult CheckLevelEnd();
+
+	void SpawnEnemy();
+	void SpawnAsteroid();
+	void SpawnBullet(const olc::vf2d& startPos);
+	void SpawnEnemyBullet(const olc::vf2d& startPos);
+	void SpawnBossBullets();
+	void SpawnExplosion(const olc::vf2d& pos, ExplosionKind kind, float maxTime, float size);
+
+	// Player lost a life; starts the end-of-level pause on the last one
+	void HitPlayer(const olc::vf2d& deathPos, float deathSize);
+
+	void BuildGrid(SpatialGrid& grid, const CircleArray& v);
+	int FirstHit(const SpatialGrid& grid, const CircleArray& v, const olc::vf2d& pos, float r) const;
+	std::vector<uint32_t>& AllHits(const SpatialGrid& grid, const CircleArray& v, const olc::vf2d& pos, float r);
+};
@@ -0,0 +1,988 @@
+#pragma once
+// The whole game. Include it once per executable, from the translation unit
+// that defines OLC_PGE_APPLICATION and OLC_PGEX_SOUND (and, for the headless
+// bench, OLC_PGE_HEADLESS and USE_NOAUDIO) before including the olc headers.
+#include "olcPixelGameEngine.h"
+#include "olcPGEX_Sound.h"
+
+#include "simulation.h"
+#include "input_record.h"
+#include "frame_profiler.h"
+#include "sprite_batch.h"
+#include "sprite_atlas.h"
+#include "asset_loader.h"
+#include "asset_bundle.h"
+#include "asset_manager.h"
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <future>
+#include <utility>
+#include <cmath> 
+#include <cstring>
+#include <cstdlib>
+
+enum class GameState {
+    MENU,
+    STORY,
+    LEVEL_INTRO,
+    LEVEL_PLAY,
+    PAUSED,
+    GAME_OVER
+};
+
+// --- Story Image Structure ---
+// Only the path and text stay resident; the image is loaded while its
+// sequence plays and released once the player has moved past it
+struct StorySlide {
+    AssetManager::ImageHandle image;
+    std::string text;
+    std::string path;
+};
+
+class SpaceShooter : public olc::PixelGameEngine
+{
+public:
+    SpaceShooter()
+    {
+        sAppName = "Operation Starfall";
+    }
+
+    // ---- Cinematic story motion ----
+    float storyT = 0.0f;
+    int lastStoryIndex = -1;
+
+    float panX = 30.0f;
+    float panY = 18.0f;
+
+    float panSpeedX = 0.08f;  // slower
+    float panSpeedY = 0.05f;
+
+    float zoomAmp = 0.03f;
+    float zoomSpeed = 0.04f;
+
+    float storyOverscale = 1.15f; // start with 1.15 not 1.25
+    bool storyMusicPlayed = false;
+
+    // Owns every image kept past startup; declared before anything holding
+    // a handle, so it is destroyed after all of them
+    AssetManager assetManager;
+
+    // --- Story Image Structure ---
+    std::vector<StorySlide> storyIntro;
+    std::vector<StorySlide> storyLevel2;
+    std::vector<StorySlide> storyLevel3;
+    std::vector<StorySlide> storyWin;
+    std::vector<StorySlide> storyLose;
+
+    // --- Sprites ---
+    // Every gameplay sprite is packed into one atlas texture, so a level
+    // frame binds a single texture however many kinds of sprite it draws
+    SpriteAtlas atlas;
+    AssetManager::ImageHandle atlasImage;
+    SpriteRegion regBackground;
+    SpriteRegion regBoomAsteroid;
+    SpriteRegion regBoomShip;
+
+    // --- Loading ---
+    // Assets come pre-decoded from the bundle when there is one (see
+    // bench/bundle_assets.cpp; --bundle file, --no-bundle to decode the
+    // files instead), anything it lacks from the files themselves
+    AssetBundle bundle;
+    std::string bundlePath = "assets.bundle";
+
+    // Sprites and sounds decode on worker threads while the menu is up
+    // (--load-threads N, 0 for the old serial load on the engine thread)
+    AssetLoader assets;
+    bool assetsReady = false;
+
+    struct PendingSound {
+        AssetManager::SoundHandle* sound;
+        std::string path;
+        std::shared_ptr<olc::SOUND::AudioSample> sample;
+    };
+    std::vector<PendingSound> pendingSounds;
+    std::vector<std::pair<std::string, olc::Sprite*>> atlasSources;
+
+    // Background scroll
+    float bgOffset = 0.0f;
+
+    // Every in-level sprite goes through this, one decal at a time
+    SpriteBatch sprites;
+
+    // --- Gameplay, everything the sound and drawing code reads ---
+    Simulation sim;
+
+    // Gameplay runs in fixed ticks; rendering interpolates between the last two
+    float simTickRate = 120.0f;
+    float simAccumulator = 0.0f;
+    const float maxFrameTime = 0.25f; // drop time after a stall instead of spiralling
+
+    // Random
+    uint32_t rngSeed = std::random_device{}();
+
+    // Deterministic mode (--seed N): fixed seed and exactly one simulation
+    // tick per frame regardless of wall-clock time, so the same input gives
+    // bit-identical entity state on the same build. Each level reseeds from
+    // rngSeed, so its spawns don't depend on how long the menus took.
+    bool deterministic = false;
+
+    // Keys read this frame, live or from a replay. Recording and replay
+    // force deterministic mode, so one frame is exactly one tick.
+    InputState input;
+    InputRecording recording;
+    std::string recordPath;
+    bool replaying = false;
+    size_t replayTick = 0;
+
+    // F3 toggles the overlay; --profile file.csv also dumps every frame on exit
+    FrameProfiler profiler;
+    std::string profilePath;
+
+    // Timer & Level
+    GameState state = GameState::MENU;
+
+    float introTimer = 0.0f;
+    std::vector<StorySlide>* currentStory = nullptr;
+    int storyIndex = 0;
+
+    // The slide after the current one, decoding in the background
+    std::future<olc::Sprite*> slidePrefetch;
+    size_t prefetchIndex = 0;
+
+    // Levels whose asset budget has been printed, one bit each
+    uint32_t budgetsReported = 0;
+
+    GameState stateBeforePause = GameState::MENU; // Remember state before pausing
+    int pauseSelection = 0; // 0 = Resume, 1 = Exit to Menu
+
+    // Sound IDs; the music streams from disk, so only the effects are assets
+    int sndStory = -1;
+    int sndStoryWin = -1;
+    AssetManager::SoundHandle sndShoot;
+    AssetManager::SoundHandle sndLevelComplete;
+    AssetManager::SoundHandle sndMenu;
+    AssetManager::SoundHandle sndPlayerHit;
+    AssetManager::SoundHandle sndExplosion;
+    AssetManager::SoundHandle sndGameOver;
+
+    // Turns the tick's gameplay events into sounds
+    void playEvents() {
+        for (SimEvent e : sim.events) {
+            switch (e) {
+            case SimEvent::SHOOT:          olc::SOUND::PlaySample(sndShoot.Id()); break;
+            case SimEvent::EXPLOSION:      olc::SOUND::PlaySample(sndExplosion.Id()); break;
+            case SimEvent::PLAYER_HIT:     olc::SOUND::PlaySample(sndPlayerHit.Id()); break;
+            case SimEvent::GAME_OVER:      olc::SOUND::PlaySample(sndGameOver.Id()); break;
+            case SimEvent::LEVEL_COMPLETE: olc::SOUND::PlaySample(sndLevelComplete.Id()); break;
+            }
+        }
+        sim.events.clear();
+    }
+
+    bool OnUserCreate() override
+    {
+        olc::SOUND::InitialiseAudio();
+
+        if (!bundlePath.empty() && bundle.Open(bundlePath)) {
+            std::cout << "Using asset bundle " << bundlePath << "\n";
+            if (bundle.Stale() > 0)
+                std::cout << "  " << bundle.Stale() << " assets changed since it was built, loading those from assets/\n";
+            assets.bundle = &bundle;
+            assetManager.bundle = &bundle;
+        }
+
+        // Load sounds
+        // The story tracks are long, so they play from disk instead of
+        // sitting decoded in memory. Only their headers are read here.
+        sndStory = olc::SOUND::LoadAudioStream("assets/audio/story.wav");
+        sndStoryWin = olc::SOUND::LoadAudioStream("assets/audio/story_win.wav");
+
+        // Everything else is decoded by the loader while the menu shows
+        queueSound(sndShoot, "assets/audio/shoot.wav");
+        queueSound(sndLevelComplete, "assets/audio/level_complete.wav");
+        queueSound(sndMenu, "assets/audio/menu.wav");
+        queueSound(sndPlayerHit, "assets/audio/player_hit.wav");
+        queueSound(sndExplosion, "assets/audio/explosion.wav");
+        queueSound(sndGameOver, "assets/audio/game_over.wav");
+
+        // Story images are only loaded while their sequence plays
+
+        // Intro story (4 images)
+        addSlide(storyIntro, "assets/story/intro1.png",
+            "Earth is under siege by an alien invasion force.");
+        addSlide(storyIntro, "assets/story/intro2.png",
+            "You are humanity's last hope, piloting the experimental starfighter.");
+        addSlide(storyIntro, "assets/story/intro3.png",
+            "Navigate through the asteroid belt and eliminate all threats!");
+        addSlide(storyIntro, "assets/story/intro4.png",
+            "Navigate through the asteroid belt and eliminate all threats!");
+        addSlide(storyIntro, "assets/story/intro5.png",
+            "Navigate through the asteroid belt and eliminate all threats!");
+
+        // Level 2 story (3 images)
+        addSlide(storyLevel2, "assets/story/level2_1.png",
+            "You've cleared the asteroid belt! Enemy fighters approaching...");
+        addSlide(storyLevel2, "assets/story/level2_2.png",
+            "Eliminate all enemy ships to proceed!");
+        addSlide(storyLevel2, "assets/story/level2_3.png",
+            "Eliminate all enemy ships to proceed!");
+
+        // Level 3 story (2 images)
+        addSlide(storyLevel3, "assets/story/level3_1.png",
+            "The enemy fleet has been decimated!");
+        addSlide(storyLevel3, "assets/story/level3_2.png",
+            "But their mothership has entered Earth's orbit. Destroy it!");
+        addSlide(storyLevel3, "assets/story/level3_3.png",
+            "But their mothership has entered Earth's orbit. Destroy it!");
+
+        // Win story (4 images)
+        addSlide(storyWin, "assets/story/win1.png",
+            "The mothership explodes in a brilliant flash!");
+        addSlide(storyWin, "assets/story/win2.png",
+            "Earth is saved! You are a hero!");
+        addSlide(storyWin, "assets/story/win3.png",
+            "Earth is saved! You are a hero!");
+        addSlide(storyWin, "assets/story/win4.png",
+            "Earth is saved! You are a hero!");
+
+        // Lose story (2 images)
+        addSlide(storyLose, "assets/story/lose1.png",
+            "Your ship takes critical damage...");
+        addSlide(storyLose, "assets/story/lose2.png",
+            "Humanity falls to the invasion...");
+        addSlide(storyLose, "assets/story/lose3.png",
+            "Humanity falls to the invasion...");
+
+        // Load sprites into the atlas
+        queueAtlas("bg_space", "assets/sprites/bg_space.png");
+        queueAtlas("player_ship", "assets/sprites/player_ship.png");
+        queueAtlas("asteroid", "assets/sprites/asteroid.png");
+        queueAtlas("enemy_ship", "assets/sprites/enemy_ship.png");
+        queueAtlas("boss_ship", "assets/sprites/boss_ship.png");
+        queueAtlas("bullet", "assets/sprites/bullet.png");
+        queueAtlas("boom_asteroid", "assets/sprites/boom_asteroid.png");
+        queueAtlas("boom_ship", "assets/sprites/boom_ship.png");
+
+        sim.Init(ScreenWidth(), ScreenHeight(), rngSeed);
+        sim.phases.enabled = true;
+
+        assets.Start();
+
+        // Replays and benches start from a fully loaded game, so frame N
+        // is the same frame however long the decoding took
+        if (deterministic) {
+            assets.Wait();
+            assetsLoaded();
+        }
+
+        state = GameState::MENU;
+        return true;
+    }
+
+    // Queues a WAV for the loader; the handle is filled in assetsLoaded
+    void queueSound(AssetManager::SoundHandle& sound, const std::string& path) {
+        auto sample = std::make_shared<olc::SOUND::AudioSample>();
+        assets.Add([this, sample, path]() { loadSound(*sample, path); });
+        pendingSounds.push_back({ &sound, path, sample });
+    }
+
+    // From the bundle when it has the sound, otherwise decoded from the WAV.
+    // Safe from any thread.
+    bool loadSound(olc::SOUND::AudioSample& sample, const std::string& path) const {
+        const AssetBundle::Entry* e = bundle.Find(path);
+        if (e && e->kind == AssetBundle::SOUND)
+            return sample.LoadFromPCM(static_cast<const float*>(bundle.Data(*e)), long(e->frames),
+                int(e->channels), e->sampleRate) == olc::OK;
+        return sample.LoadFromFile(path) == olc::OK;
+    }
+
+    // Adds a story slide; its image is loaded by beginStory
+    void addSlide(std::vector<StorySlide>& story, const std::string& path, const std::string& text) {
+        story.push_back({ {}, text, path });
+    }
+
+    // Queues an atlas image; it is packed in assetsLoaded
+    void queueAtlas(const std::string& name, const std::string& path) {
+        size_t i = atlasSources.size();
+        atlasSources.push_back({ name, nullptr });
+        assets.AddSprite(path, [this, i](olc::Sprite* sprite) { atlasSources[i].second = sprite; });
+    }
+
+    // Runs once on the engine thread when the last asset is in. Sounds are
+    // registered and the atlas packed in queue order, so sound ids and the
+    // atlas layout never depend on which worker finished first. The mixer
+    // is already running by now; AddAudioSample publishes each sound to it
+    // without disturbing the ones playing, and the policies set below go
+    // through the same command queue as PlaySample.
+    void assetsLoaded() {
+        for (PendingSound& p : pendingSounds) {
+            int id = olc::SOUND::AddAudioSample(*p.sample);
+            *p.sound = assetManager.TrackSound(p.path, id, size_t(p.sample->nSamples) * p.sample->nChannels * sizeof(float));
+            if (!*p.sound)
+                std::cout << "Could not load " << p.path << ", it will stay silent\n";
+        }
+        pendingSounds.clear();
+
+        // Bound how many copies of the busiest effects can stack up, so a
+        // screen-clearing volley costs the mixer the same as a quiet moment
+        olc::SOUND::sVoicePolicy shots;
+        shots.nMaxVoices = 3;
+        shots.steal = olc::SOUND::sVoicePolicy::Steal::OLDEST;
+        shots.fMinRetrigger = 0.05f;
+        olc::SOUND::SetVoicePolicy(sndShoot.Id(), shots);
+
+        olc::SOUND::sVoicePolicy booms;
+        booms.nMaxVoices = 6;
+        booms.steal = olc::SOUND::sVoicePolicy::Steal::QUIETEST;
+        booms.fMinRetrigger = 0.03f;
+        olc::SOUND::SetVoicePolicy(sndExplosion.Id(), booms);
+
+        olc::SOUND::sVoicePolicy menu;
+        menu.nMaxVoices = 1;
+        olc::SOUND::SetVoicePolicy(sndMenu.Id(), menu);
+
+        for (auto& [name, sprite] : atlasSources) atlas.Add(name, sprite);
+        atlasSources.clear();
+        if (atlas.Build()) atlasImage = assetManager.Adopt("atlas", AssetManager::Group::GAME, atlas.sprite, atlas.decal);
+
+        regBackground = atlas.Find("bg_space");
+        regBoomAsteroid = atlas.Find("boom_asteroid");
+        regBoomShip = atlas.Find("boom_ship");
+
+        sim.player.sprite = atlas.Find("player_ship");
+        sim.boss.sprite = atlas.Find("boss_ship");
+        sim.asteroids.sprite = atlas.Find("asteroid");
+        sim.enemies.sprite = atlas.Find("enemy_ship");
+        sim.bullets.sprite = atlas.Find("bullet");
+        sim.enemyBullets.sprite = sim.bullets.sprite;
+
+        assets.Report(std::cout);
+        assetsReady = true;
+    }
+
+    void ResetGame() {
+        sim.ResetGame();
+        beginStory(storyIntro);
+    }
+
+    // Shows 'story' from its first slide. That slide is decoded now, the
+    // one after it in the background while the first is on screen.
+    void beginStory(std::vector<StorySlide>& story) {
+        endStory();
+        currentStory = &story;
+        storyIndex = 0;
+        state = GameState::STORY;
+        loadSlide(0);
+    }
+
+    // Gives slide i its decal, taking the prefetched image if it is the
+    // one being decoded (waiting for it if need be), then starts on i + 1.
+    // Slides already shown are freed, so at most two are resident.
+    void loadSlide(size_t i) {
+        std::vector<StorySlide>& story = *currentStory;
+        for (size_t k = 0; k < i && k < story.size(); k++) releaseSlide(story[k]);
+        if (i >= story.size()) return;
+
+        olc::Sprite* prefetched = nullptr;
+        if (slidePrefetch.valid()) {
+            prefetched = slidePrefetch.get();
+            if (prefetchIndex != i) {
+                delete prefetched;
+                prefetched = nullptr;
+            }
+        }
+        if (prefetched)
+            story[i].image = assetManager.Adopt(story[i].path, AssetManager::Group::STORY, prefetched);
+        else if (!story[i].image)
+            story[i].image = assetManager.Load(story[i].path, AssetManager::Group::STORY);
+
+        // Nothing to decode if another slide already holds the same image
+        if (i + 1 < story.size() && !story[i + 1].image)
+            story[i + 1].image = assetManager.Find(story[i + 1].path);
+        if (i + 1 < story.size() && !story[i + 1].image) {
+            prefetchIndex = i + 1;
+            slidePrefetch = std::async(std::launch::async,
+                [this, path = story[i + 1].path]() { return bundle.LoadSprite(path); });
+        }
+    }
+
+    // Leaving the sequence releases the whole story group, including a
+    // slide still held for the screen just drawn, plus one still decoding
+    void endStory() {
+        if (slidePrefetch.valid()) delete slidePrefetch.get();
+        if (!currentStory) return;
+
+        assetManager.ReleaseGroup(AssetManager::Group::STORY);
+        for (StorySlide& slide : *currentStory) slide.image.Reset();
+        currentStory = nullptr;
+    }
+
+    // A slide the player has moved past, while the sequence goes on. The
+    // manager frees the image before the next frame, once this one (which
+    // may still draw it) is done.
+    static void releaseSlide(StorySlide& slide) {
+        slide.image.Reset();
+    }
+
+    void startLevel(int lvl) {
+        if (sim.pooledLevel > 0) sim.ReportPoolUsage(std::cout);
+        if (deterministic) sim.Seed(rngSeed + uint32_t(lvl) * 0x9E3779B9u);
+        sim.StartLevel(lvl);
+        simAccumulator = 0.0f;
+
+        // What the level keeps resident, printed the first time it starts
+        if (!(budgetsReported & (1u << lvl))) {
+            budgetsReported |= 1u << lvl;
+            assetManager.Report(std::cout, "Level " + std::to_string(lvl) + " assets:");
+        }
+    }
+
+    // Moves on once a level's end-of-level pause has run out
+    void finishLevel(LevelResult result) {
+        if (result == LevelResult::CLEARED)
+            beginStory(sim.currentLevel == 1 ? storyLevel2 : storyLevel3);
+        else if (result == LevelResult::WON)
+            beginStory(storyWin);
+        else
+            beginStory(storyLose);
+    }
+
+    bool OnUserDestroy() override
+    {
+        if (sim.pooledLevel > 0) sim.ReportPoolUsage(std::cout);
+
+        if (!recordPath.empty()) {
+            if (recording.Save(recordPath))
+                std::cout << "Recorded " << recording.ticks.size() << " ticks to " << recordPath << "\n";
+            else
+                std::cout << "Could not write recording " << recordPath << "\n";
+        }
+
+        if (!profilePath.empty()) {
+            if (profiler.WriteCsv(profilePath))
+                std::cout << "Wrote " << profiler.history.size() << " profiled frames to " << profilePath << "\n";
+            else
+                std::cout << "Could not write profile " << profilePath << "\n";
+        }
+
+        // Joins the loader, audio and music streaming threads before statics go away
+        assets.Stop();
+        endStory();
+        olc::SOUND::DestroyAudio();
+        return true;
+    }
+
+    bool OnUserUpdate(float dt) override
+    {
+        const float frameTime = dt;
+
+        // Frame time never reaches the simulation in deterministic mode
+        if (deterministic) dt = 1.0f / simTickRate;
+
+        if (replaying) {
+            if (replayTick >= recording.ticks.size()) {
+                std::cout << "Replay finished after " << replayTick << " ticks\n";
+                return false;
+            }
+            input = recording.ticks[replayTick++];
+        }
+        else {
+            input = InputState::Capture(this);
+            if (!recordPath.empty()) recording.ticks.push_back(input);
+        }
+
+        // Last frame has been drawn, so images released during it can go
+        assetManager.Collect();
+
+        // Decals for whatever the loader finished since the last frame
+        if (!assetsReady && assets.Poll()) assetsLoaded();
+
+        Clear(olc::BLACK);
+
+        // Handle ESC key to pause/unpause
+        if (input.Has(InputBit::PRESSED_ESCAPE)) {
+            olc::SOUND::PlaySample(sndMenu.Id());
+
+            if (state == GameState::LEVEL_PLAY || state == GameState::LEVEL_INTRO || state == GameState::STORY) {
+                stateBeforePause = state;
+                state = GameState::PAUSED;
+                pauseSelection = 0;
+            }
+            else if (state == GameState::PAUSED) {
+                state = stateBeforePause;
+            }
+        }
+
+        switch (state)
+        {
+
+        case GameState::MENU:
+        {
+            DrawString(ScreenWidth() / 2 - 130, ScreenHeight() / 2 - 60,
+                "OPERATION STARFALL", olc::WHITE, 2);
+            if (assetsReady) {
+                DrawString(ScreenWidth() / 2 - 100, ScreenHeight() / 2 - 10,
+                    "Press ENTER to Start", olc::YELLOW, 1);
+            }
+            else {
+                // Loading bar in place of the prompt until every asset is in
+                int barW = 200;
+                int barX = ScreenWidth() / 2 - barW / 2;
+                int barY = ScreenHeight() / 2 - 12;
+                DrawRect(barX, barY, barW, 10, olc::YELLOW);
+                FillRect(barX + 2, barY + 2, int((barW - 3) * assets.Progress()), 7, olc::YELLOW);
+                DrawString(barX, barY + 14, "Loading " + std::to_string(assets.Done()) + " / " +
+                    std::to_string(assets.Total()), olc::YELLOW, 1);
+            }
+            DrawString(ScreenWidth() / 2 - 120, ScreenHeight() / 2 + 30,
+                "Arrow Keys / WASD to Move", olc::CYAN, 1);
+            DrawString(ScreenWidth() / 2 - 90, ScreenHeight() / 2 + 50,
+                "Auto-Fire Enabled!", olc::GREEN, 1);
+
+            if (assetsReady && input.Has(InputBit::PRESSED_ENTER)) {
+                olc::SOUND::PlaySample(sndMenu.Id());
+                ResetGame();
+            }
+            break;
+        }
+        case GameState::STORY:
+        {   
+            // Play story music once when entering story
+            if (!storyMusicPlayed) {
+                olc::SOUND::PlaySample(sndStory, true); // true = loop
+                storyMusicPlayed = true;
+            }
+
+            // Draw current story image
+            if (currentStory && size_t(storyIndex) < currentStory->size()) {
+                StorySlide& slide = (*currentStory)[storyIndex];
+
+                // Reset cinematic motion on slide change
+                if (storyIndex != lastStoryIndex) {
+                    lastStoryIndex = storyIndex;
+                    storyT = 0.0f;
+                }
+                storyT += dt;
+
+
+                // Fit image to screen
+                float scale = std::min(
+                    float(ScreenWidth()) / slide.image.Sprite()->width,
+                    float(ScreenHeight() - 100) / slide.image.Sprite()->height
+                );
+
+                scale = std::min(scale, 1.8f);
+
+                // Smooth cinematic pan
+                float offX = panX * std::sin(2.0f * 3.14159f * panSpeedX * storyT);
+                float offY = panY * std::cos(2.0f * 3.14159f * panSpeedY * storyT);
+
+                // Gentle zoom
+                float zoom = 1.0f + zoomAmp * std::sin(2.0f * 3.14159f * zoomSpeed * storyT);
+                float finalScale = scale * storyOverscale * zoom;
+
+                // Final size
+                olc::vf2d size = {
+                    slide.image.Sprite()->width * finalScale,
+                    slide.image.Sprite()->height * finalScale
+                };
+
+                // Center + drift
+                olc::vf2d basePos = {
+                    (ScreenWidth() - size.x) / 2.0f,
+                    (ScreenHeight() - 100 - size.y) / 2.0f
+                };
+
+                olc::vf2d pos = basePos + olc::vf2d{ offX, offY };
+                pos.y -= 40.0f;
+
+                DrawDecal(pos, slide.image.Decal(), { finalScale, finalScale });
+
+
+
+
+                // Draw text box at bottom
+                FillRect(0, ScreenHeight() - 80, ScreenWidth(), 80,
+                    olc::Pixel(0, 0, 0, 220));
+                DrawRect(0, ScreenHeight() - 80, ScreenWidth(), 80, olc::WHITE);
+
+                // Center the text
+                int textWidth = slide.text.length() * 8;
+                int textX = (ScreenWidth() - textWidth) / 2;
+                DrawString(textX, ScreenHeight() - 60, slide.text, olc::WHITE, 1);
+
+                // Instruction
+                DrawString(ScreenWidth() / 2 - 100, ScreenHeight() - 30,
+                    "Press ENTER to continue", olc::YELLOW, 1);
+            }
+
+            if (input.Has(InputBit::PRESSED_ENTER)) {
+                olc::SOUND::PlaySample(sndMenu.Id());
+                storyIndex++;
+                if (currentStory) loadSlide(storyIndex);
+
+                // Check if story is complete
+                if (currentStory && size_t(storyIndex) >= currentStory->size()) {
+                    // Determine what comes next
+                    if (currentStory == &storyIntro) {
+                        startLevel(1);  // ← Explicitly level 1
+                        introTimer = 0.0f;
+                        state = GameState::LEVEL_INTRO;
+                    }
+                    else if (currentStory == &storyLevel2) {
+                        startLevel(2);  // ← Explicitly level 2
+                        introTimer = 0.0f;
+                        state = GameState::LEVEL_INTRO;
+                    }
+                    else if (currentStory == &storyLevel3) {
+                        startLevel(3);  // ← Explicitly level 3
+                        introTimer = 0.0f;
+                        state = GameState::LEVEL_INTRO;
+                    }
+                    else if (currentStory == &storyWin || currentStory == &storyLose) {
+                        // Go to game over
+                        state = GameState::GAME_OVER;
+                    }
+                    endStory();
+                }
+            }
+            break;
+        }
+
+        case GameState::LEVEL_INTRO:
+        {
+            introTimer += dt;
+            bool visible = fmodf(introTimer * 4.0f, 2.0f) < 1.0f;
+
+            std::string title;
+            if (sim.currentLevel == 1)
+                title = "LEVEL 1: ASTEROID BELT";
+            else if (sim.currentLevel == 2)
+                title = "LEVEL 2: FRONTIER ZONE";
+            else if (sim.currentLevel == 3)
+                title = "LEVEL 3: ORBITAL SIEGE";
+
+            if (visible) {
+                int tw = int(title.size() * 8 * 2);
+                int x = ScreenWidth() / 2 - tw / 2;
+                int y = ScreenHeight() / 2 - 10;
+                DrawString(x, y, title, olc::WHITE, 2);
+            }
+
+            DrawString(ScreenWidth() / 2 - 90, ScreenHeight() / 2 + 30,
+                "Press ENTER to Begin", olc::YELLOW, 1);
+
+            if (input.Has(InputBit::PRESSED_ENTER)) {
+                olc::SOUND::PlaySample(sndMenu.Id());
+                state = GameState::LEVEL_PLAY;
+            }
+            break;
+        }
+
+        case GameState::LEVEL_PLAY:
+        {
+            
+            // 2. DRAW BACKGROUND (Lowest layer)
+            // Each tile is stretched to cover the screen when the image is
+            // smaller than it (a bundle built with --max-size), and the
+            // scroll runs in screen pixels, so speed and coverage don't
+            // depend on the stored size
+            float bgScale = 1.0f;
+            if (regBackground) {
+                bgScale = std::max({ 1.0f,
+                    float(ScreenWidth()) / regBackground.size.x,
+                    float(ScreenHeight()) / regBackground.size.y });
+            }
+            float bgTileHeight = regBackground.size.y * bgScale;
+
+            if(state != GameState::PAUSED && !sim.isTransitioning){
+            bgOffset += 40.0f * dt;
+                if (bgOffset >= bgTileHeight)
+                    bgOffset -= bgTileHeight;
+            }
+
+            // Draw background decals. Batched like everything after it,
+            // since batches are drawn before plain decals
+            if (regBackground) {
+                sprites.Begin(this, regBackground, olc::DecalMode::ADDITIVE);
+                sprites.Add({ 0.0f, -bgOffset }, { bgScale, bgScale });
+                sprites.Add({ 0.0f, -bgOffset + bgTileHeight }, { bgScale, bgScale });
+                sprites.End();
+            }
+
+            // 3. RUN GAME LOGIC/UPDATE/COLLISIONS
+            // Fixed ticks keep the simulation identical at any frame rate
+            const float tick = 1.0f / simTickRate;
+            simAccumulator += std::min(dt, maxFrameTime);
+            while (simAccumulator >= tick && state == GameState::LEVEL_PLAY) {
+                LevelResult result = sim.Tick(tick, input);
+                playEvents();
+                simAccumulator -= tick;
+
+                if (result != LevelResult::PLAYING) finishLevel(result);
+            }
+            float alpha = simAccumulator / tick;
+
+            // 4. DRAW ENTITIES (Middle layers)
+            // One batch for all of them, switching atlas region per kind
+            sim.phases.Start(PhaseTimer::DRAW_ENTITIES);
+            sprites.Begin(this, atlas.decal);
+            sim.asteroids.Draw(this, sprites, alpha);
+            sim.enemies.Draw(this, sprites, alpha);
+            if (sim.boss.alive && sim.currentLevel == 3) sim.boss.Draw(this, sprites, alpha);
+            sim.enemyBullets.Draw(this, sprites, alpha);
+            sim.bullets.Draw(this, sprites, alpha);
+            sim.player.Draw(this, sprites, alpha); // Draw Player on top of other entities
+            sprites.End();
+
+            sim.phases.Start(PhaseTimer::DRAW_EXPLOSIONS);
+            // One additive batch for both explosion sprites, grouped by kind.
+            // Additive blending for the glow also means the grouping can't
+            // change how overlaps look
+            sprites.Begin(this, atlas.decal, olc::DecalMode::ADDITIVE);
+            for (ExplosionKind kind : { ExplosionKind::ASTEROID, ExplosionKind::SHIP }) {
+                const SpriteRegion& region = kind == ExplosionKind::SHIP ? regBoomShip : regBoomAsteroid;
+                if (!region) continue;
+                sprites.Use(region);
+
+                for (auto& exp : sim.explosions) {
+                    if (exp.kind != kind) continue;
+                    float scale = exp.size / region.size.x;
+                    olc::vf2d size = region.size * scale;
+
+                    // Draw sprite centered on the entity's position
+                    sprites.Add(exp.pos - size / 2.0f, { scale, scale });
+                }
+            }
+            sprites.End();
+
+            // 5. DRAW HUD (Top layer)
+            sim.phases.Start(PhaseTimer::DRAW_HUD);
+
+            // Solid black background for main HUD (left side), reduced size, higher opacity (240)
+            FillRect(0, 0, 220, 115, olc::Pixel(0, 0, 0, 240));
+            DrawRect(0, 0, 220, 115, olc::WHITE); // Border
+
+            std::string lvlText;
+            if (sim.currentLevel == 1)
+                lvlText = "LEVEL 1: ASTEROID BELT";
+            else if (sim.currentLevel == 2)
+                lvlText = "LEVEL 2: FRONTIER ZONE";
+            else if (sim.currentLevel == 3)
+                lvlText = "LEVEL 3: ORBITAL SIEGE";
+
+            // Draw Level Text (Slightly larger scale 2.0x)
+            DrawString(8, 8, lvlText, olc::WHITE, 1.5f);
+            DrawLine(8, 25, 212, 25, olc::Pixel(100, 100, 100)); // Thin separator line
+
+            // Draw Stats (Consistent 1.5x scale)
+            DrawString(8, 35, "Score: " + std::to_string(sim.score), olc::YELLOW, 1.5f);
+            DrawString(8, 55, "Lives: " + std::to_string(sim.player.lives), olc::GREEN, 1.5f);
+            DrawString(8, 75, "Hits Taken: " + std::to_string(sim.hits), olc::RED, 1.5f);
+
+            // Objective display (larger scale 2.0x for focus)
+            if (sim.currentLevel == 1) {
+                float targetDuration = sim.level1Duration;
+                int timeLeft = int(std::max(0.0f, targetDuration - sim.levelTime));
+                DrawString(8, 95, "TIME: " + std::to_string(timeLeft) + "s", olc::CYAN, 1.8f);
+            }
+            else if (sim.currentLevel == 2) {
+                int killed = sim.enemiesKilled;
+                int target = sim.level2KillTarget;
+                DrawString(8, 95, "KILLS: " + std::to_string(killed) + "/" + std::to_string(target), olc::CYAN, 1.8f);
+            }
+            else if (sim.currentLevel == 3) {
+                // --- Right HUD Panel (Boss HP) ---
+                int barW = 200;
+                int barH = 15; // Slightly thinner bar
+                int barX = ScreenWidth() - barW - 15; // Move closer to right edge
+                int barY = 25; // Move higher up
+
+                float hpRatio = sim.boss.alive ? float(sim.boss.hp) / float(sim.boss.maxHp) : 0.0f;
+                int hpW = int(barW * hpRatio);
+
+                // Background box for boss HP area (Condensed to height 60)
+                FillRect(barX - 10, barY - 25, barW + 20, 60, olc::Pixel(0, 0, 0, 240));
+                DrawRect(barX - 10, barY - 25, barW + 20, 60, olc::WHITE);
+
+                // Label above bar
+                // Adjusted Y-coordinate (-15) to sit closer to the bar
+                DrawString(barX + 65, barY - 15, "BOSS HP", olc::WHITE, 1.0f); // Reduced text scale for max compactness
+
+                // HP bar outline
+                DrawRect(barX - 2, barY - 2, barW + 4, barH + 4, olc::WHITE);
+                // Background
+                FillRect(barX, barY, barW, barH, olc::VERY_DARK_RED);
+                // Current HP
+                if (hpW > 0) {
+                    olc::Pixel hpColor = hpRatio > 0.5f ? olc::GREEN : (hpRatio > 0.25f ? olc::YELLOW : olc::RED);
+                    FillRect(barX, barY, hpW, barH, hpColor);
+                }
+
+                // HP text below bar
+                // Adjusted Y-coordinate (+18) to sit closer to the bar
+                std::string hpText = std::to_string(sim.boss.hp) + " / " + std::to_string(sim.boss.maxHp);
+                DrawString(barX + 55, barY + 18, hpText, olc::WHITE, 1.5f);
+            }
+
+
+            sim.phases.Stop();
+
+            // Debug overlay, drawn outside the timed phases
+            if (GetKey(olc::Key::F3).bPressed) profiler.overlay = !profiler.overlay;
+
+            uint32_t counts[FrameProfiler::COUNTERS] = {
+                uint32_t(sim.asteroids.Size()), uint32_t(sim.bullets.Size()), uint32_t(sim.enemies.Size()),
+                uint32_t(sim.enemyBullets.Size()), uint32_t(sim.explosions.Size())
+            };
+            profiler.EndFrame(sim.phases, frameTime, counts);
+            if (profiler.overlay) profiler.DrawOverlay(this, 4, ScreenHeight() - 236);
+            break;
+        }
+
+        case GameState::PAUSED:
+        {
+            // Just draw solid black background - no need to show what's behind
+            FillRect(0, 0, ScreenWidth(), ScreenHeight(), olc::Pixel(0, 0, 0, 255));
+
+            // Draw pause menu box
+            int boxW = 400;
+            int boxH = 300;
+            int boxX = ScreenWidth() / 2 - boxW / 2;
+            int boxY = ScreenHeight() / 2 - boxH / 2;
+
+            FillRect(boxX, boxY, boxW, boxH, olc::Pixel(20, 20, 40));
+            DrawRect(boxX, boxY, boxW, boxH, olc::WHITE);
+
+            DrawString(boxX + boxW / 2 - 40, boxY + 30, "PAUSED", olc::YELLOW, 3);
+
+            std::string option1 = "RESUME";
+            std::string option2 = "EXIT TO MENU";
+
+            olc::Pixel color1 = (pauseSelection == 0) ? olc::GREEN : olc::WHITE;
+            olc::Pixel color2 = (pauseSelection == 1) ? olc::GREEN : olc::WHITE;
+
+            DrawString(boxX + boxW / 2 - 40, boxY + 120, option1, color1, 2);
+            DrawString(boxX + boxW / 2 - 90, boxY + 170, option2, color2, 2);
+
+            DrawString(boxX + 60, boxY + boxH - 40, "UP/DOWN to select, ENTER to confirm", olc::CYAN, 1);
+
+            if (input.Has(InputBit::PRESSED_UP) || input.Has(InputBit::PRESSED_W)) {
+                olc::SOUND::PlaySample(sndMenu.Id());
+                pauseSelection = 0;
+            }
+            if (input.Has(InputBit::PRESSED_DOWN) || input.Has(InputBit::PRESSED_S)) {
+                olc::SOUND::PlaySample(sndMenu.Id());
+                pauseSelection = 1;
+            }
+
+            if (input.Has(InputBit::PRESSED_ENTER)) {
+                olc::SOUND::PlaySample(sndMenu.Id());
+                if (pauseSelection == 0) {
+                    state = stateBeforePause;
+                }
+                else if (pauseSelection == 1) {
+                    if (stateBeforePause == GameState::STORY) endStory();
+                    state = GameState::MENU;
+                }
+            }
+
+            break;
+        }
+
+        case GameState::GAME_OVER:
+        {
+            std::string line1 = sim.wins ? "MISSION COMPLETE!" : "MISSION FAILED";
+            std::string line2 = sim.wins ? "Earth is Saved!" : "Earth has Fallen";
+            std::string line3 = "Final Score: " + std::to_string(sim.score);
+            std::string line4 = "Press ENTER for Menu";
+
+            int x1 = ScreenWidth() / 2 - int(line1.size()) * 8;
+            int x2 = ScreenWidth() / 2 - int(line2.size()) * 8;
+            int x3 = ScreenWidth() / 2 - int(line3.size()) * 8;
+            int x4 = ScreenWidth() / 2 - int(line4.size()) * 8;
+
+            olc::Pixel color1 = sim.wins ? olc::GREEN : olc::RED;
+            olc::Pixel color2 = sim.wins ? olc::YELLOW : olc::DARK_RED;
+
+            DrawString(x1, ScreenHeight() / 2 - 40, line1, color1, 2);
+            DrawString(x2, ScreenHeight() / 2 - 5, line2, color2, 1);
+            DrawString(x3, ScreenHeight() / 2 + 25, line3, olc::WHITE, 1);
+            DrawString(x4, ScreenHeight() / 2 + 55, line4, olc::CYAN, 1);
+
+            if (input.Has(InputBit::PRESSED_ENTER)) {
+                olc::SOUND::PlaySample(sndMenu.Id());
+                state = GameState::MENU;
+            }
+            break;
+        }
+        }
+
+        // Only the offline sound backend mixes here; a device keeps its own time
+        sim.phases.Start(PhaseTimer::AUDIO_MIX);
+        olc::SOUND::Advance(dt);
+        sim.phases.Stop();
+        return true;
+    }
+
+    // Handles --seed, --profile, --record and --replay; anything else is left for the
+    // caller. Returns false if a replay could not be loaded.
+    bool ParseCommandLine(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                rngSeed = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+                deterministic = true;
+            }
+            else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+                profilePath = argv[++i];
+                profiler.keepHistory = true;
+                profiler.history.reserve(60 * 60 * 10); // ten minutes at 60 fps before it grows
+            }
+            else if (std::strcmp(argv[i], "--bundle") == 0 && i + 1 < argc) {
+                bundlePath = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--no-bundle") == 0) {
+                bundlePath.clear();
+            }
+            else if (std::strcmp(argv[i], "--load-threads") == 0 && i + 1 < argc) {
+                assets.threads = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+                recordPath = argv[++i];
+                deterministic = true;
+            }
+            else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+                const char* path = argv[++i];
+                if (!recording.Load(path)) {
+                    std::cout << "Could not read replay " << path << "\n";
+                    return false;
+                }
+                if (recording.buildHash == 0 || BuildHash() == 0)
+                    std::cout << "No build hash to compare the replay with, it may diverge\n";
+                else if (recording.buildHash != BuildHash())
+                    std::cout << "Replay was recorded by a different build, it may diverge\n";
+
+                rngSeed = recording.seed;
+                simTickRate = recording.tickRate;
+                deterministic = true;
+                replaying = true;
+            }
+        }
+
+        if (!recordPath.empty()) {
+            recording.seed = rngSeed;
+            recording.buildHash = BuildHash();
+            recording.tickRate = simTickRate;
+            recording.ticks.reserve(size_t(simTickRate) * 60 * 60); // an hour before it grows
+        }
+
+        if (deterministic)
+            std::cout << "Deterministic mode, seed " << rngSeed << "\n";
+        return true;
+    }
+};
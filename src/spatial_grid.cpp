@@ -0,0 +1,80 @@
+#include "spatial_grid.h"
+
+void SpatialGrid::Resize(float width, float height, float cell) {
+	cellSize = cell;
+	invCellSize = 1.0f / cell;
+	cols = std::max(1, int(std::ceil(width / cell))) + 2;
+	rows = std::max(1, int(std::ceil(height / cell))) + 2;
+	originX = -cell;
+	originY = -cell;
+	cellStart.assign(size_t(cols) * rows + 1, 0);
+	cellMaxR.assign(size_t(cols) * rows, 0.0f);
+	items.clear();
+	big.Clear();
+	outside.Clear();
+}
+
+void SpatialGrid::Begin() {
+	pendingIndex.clear();
+	pendingCell.clear();
+	pendingX.clear();
+	pendingY.clear();
+	pendingR.clear();
+	big.Clear();
+	outside.Clear();
+	maxRadius = 0.0f;
+}
+
+void SpatialGrid::Add(uint32_t index, float x, float y, float r) {
+	// One oversized item would otherwise widen every query in the grid, and
+	// clamping off-grid centres would crowd the edge cells
+	if (r > cellSize) {
+		big.Add(index, x, y, r);
+		return;
+	}
+	if (!OnGrid(x, y)) {
+		outside.Add(index, x, y, r);
+		return;
+	}
+
+	pendingIndex.push_back(index);
+	pendingCell.push_back(uint32_t(CellY(y) * cols + CellX(x)));
+	pendingX.push_back(x);
+	pendingY.push_back(y);
+	pendingR.push_back(r);
+	maxRadius = std::max(maxRadius, r);
+}
+
+void SpatialGrid::End() {
+	// Counting sort by cell: count, prefix sum, then scatter.
+	// Scattering in insertion order keeps each cell's items ascending.
+	std::fill(cellStart.begin(), cellStart.end(), 0);
+	std::fill(cellMaxR.begin(), cellMaxR.end(), 0.0f);
+	for (size_t n = 0; n < pendingCell.size(); n++) {
+		uint32_t c = pendingCell[n];
+		cellStart[c + 1]++;
+		cellMaxR[c] = std::max(cellMaxR[c], pendingR[n]);
+	}
+
+	for (size_t c = 1; c < cellStart.size(); c++)
+		cellStart[c] += cellStart[c - 1];
+
+	items.resize(pendingIndex.size());
+	itemX.resize(pendingIndex.size());
+	itemY.resize(pendingIndex.size());
+	itemR.resize(pendingIndex.size());
+
+	// cellStart doubles as the per-cell write cursor
+	for (size_t n = 0; n < pendingIndex.size(); n++) {
+		uint32_t slot = cellStart[pendingCell[n]]++;
+		items[slot] = pendingIndex[n];
+		itemX[slot] = pendingX[n];
+		itemY[slot] = pendingY[n];
+		itemR[slot] = pendingR[n];
+	}
+
+	// The scatter advanced every start to the next cell's start, shift back
+	for (size_t c = cellStart.size() - 1; c > 0; c--)
+		cellStart[c] = cellStart[c - 1];
+	cellStart[0] = 0;
+}
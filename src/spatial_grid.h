@@ -0,0 +1,184 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+#include "circle_kernel.h"
+
+// Uniform grid broadphase over the playfield, plus a ring of one cell around
+// it for things just off screen (asteroids spawning above the top edge).
+// Every item no bigger than a cell is bucketed by the cell holding its centre,
+// and each cell remembers the biggest radius it holds, so a query only opens
+// the cells that could really reach it. Items bigger than a cell (a boss) and
+// items centred beyond the ring go to two small lists of their own instead of
+// piling into the edge cells. Storage is reused between rebuilds, so once
+// warmed up a Build does no heap allocation.
+struct SpatialGrid {
+	float cellSize = 64.0f;
+	float invCellSize = 1.0f / 64.0f;
+	int cols = 1;
+	int rows = 1;
+	float originX = 0.0f; // top-left corner of the ring
+	float originY = 0.0f;
+	float maxRadius = 0.0f; // of the items in cells
+
+	// cellStart[c] .. cellStart[c + 1] is the slice of 'items' living in cell c.
+	// itemX/Y/R hold each item's circle in the same order, so a cell's slice
+	// can go straight through the batched overlap kernel.
+	std::vector<uint32_t> cellStart;
+	std::vector<float> cellMaxR;
+	std::vector<uint32_t> items;
+	std::vector<float> itemX, itemY, itemR;
+
+	// Items kept out of the cells, tested one by one
+	struct Loose {
+		std::vector<uint32_t> index;
+		std::vector<float> x, y, r;
+		float maxRadius = 0.0f;
+
+		void Clear() {
+			index.clear(); x.clear(); y.clear(); r.clear();
+			maxRadius = 0.0f;
+		}
+
+		void Add(uint32_t i, float px, float py, float pr) {
+			index.push_back(i); x.push_back(px); y.push_back(py); r.push_back(pr);
+			maxRadius = std::max(maxRadius, pr);
+		}
+
+		template<typename F>
+		void Overlaps(float qx, float qy, float qr, F&& visit) const {
+			for (size_t n = 0; n < index.size(); n++) {
+				float dx = qx - x[n];
+				float dy = qy - y[n];
+				float hitR = qr + r[n];
+				if (dx * dx + dy * dy <= hitR * hitR) visit(index[n]);
+			}
+		}
+	};
+	Loose big;     // radius over cellSize
+	Loose outside; // centre off the grid
+
+	// Scratch filled by Add() and consumed by End()
+	std::vector<uint32_t> pendingIndex;
+	std::vector<uint32_t> pendingCell;
+	std::vector<float> pendingX, pendingY, pendingR;
+
+	void Resize(float width, float height, float cell);
+
+	void Begin();
+	void Add(uint32_t index, float x, float y, float r);
+	void End();
+
+	// Clamped before the cast, which then only ever truncates a positive
+	// value and so matches floor without the libm call
+	int CellX(float x) const {
+		return int(std::clamp((x - originX) * invCellSize, 0.0f, float(cols - 1)));
+	}
+
+	int CellY(float y) const {
+		return int(std::clamp((y - originY) * invCellSize, 0.0f, float(rows - 1)));
+	}
+
+	bool OnGrid(float x, float y) const {
+		return x >= originX && y >= originY && x < originX + cols * cellSize && y < originY + rows * cellSize;
+	}
+
+	// The block of cells a query for the circle (x, y, r) has to look at,
+	// given the biggest item in the grid
+	struct CellBox { int x0, y0, x1, y1; };
+	CellBox Reach(float x, float y, float r) const {
+		float reach = r + maxRadius;
+		return { CellX(x - reach), CellY(y - reach), CellX(x + reach), CellY(y + reach) };
+	}
+
+	// False when no item in cell (cx, cy) can reach the circle (x, y, r): the
+	// cell is empty, or further from the circle than its biggest item's radius
+	bool CellInReach(int cx, int cy, float x, float y, float r) const {
+		int c = cy * cols + cx;
+		if (cellStart[c] == cellStart[c + 1]) return false;
+
+		float left = originX + cx * cellSize;
+		float top = originY + cy * cellSize;
+		float dx = std::max({ left - x, 0.0f, x - (left + cellSize) });
+		float dy = std::max({ top - y, 0.0f, y - (top + cellSize) });
+		float cellReach = r + cellMaxR[c];
+		return dx * dx + dy * dy <= cellReach * cellReach;
+	}
+
+	// True when an item centred off the grid could overlap the circle
+	bool NearEdge(float x, float y, float r) const {
+		float reach = r + outside.maxRadius;
+		return x - reach < originX || y - reach < originY
+			|| x + reach >= originX + cols * cellSize || y + reach >= originY + rows * cellSize;
+	}
+
+	// Calls visit(index) for every item that might overlap the circle (x, y, r).
+	// Items inside one cell come out in the order they were added, but cells are
+	// walked row by row and the loose lists come last, so callers that care
+	// about order must sort or keep the lowest index themselves.
+	template<typename F>
+	void Query(float x, float y, float r, F&& visit) const {
+		CellBox box = Reach(x, y, r);
+		for (int cy = box.y0; cy <= box.y1; cy++) {
+			for (int cx = box.x0; cx <= box.x1; cx++) {
+				if (!CellInReach(cx, cy, x, y, r)) continue;
+				int c = cy * cols + cx;
+				for (uint32_t n = cellStart[c]; n < cellStart[c + 1]; n++)
+					visit(items[n]);
+			}
+		}
+		for (uint32_t i : big.index) visit(i);
+		if (!outside.index.empty() && NearEdge(x, y, r)) {
+			for (uint32_t i : outside.index) visit(i);
+		}
+	}
+
+	// Calls visit(index) for every item that really overlaps the circle
+	// (x, y, r), testing each busy cell's packed slice 8 circles at a time.
+	// Same ordering rules as Query().
+	template<typename F>
+	void QueryOverlaps(float x, float y, float r, F&& visit) const {
+		constexpr uint32_t chunk = 64;
+		uint8_t masks[chunk / 8];
+
+		CellBox box = Reach(x, y, r);
+		for (int cy = box.y0; cy <= box.y1; cy++) {
+			for (int cx = box.x0; cx <= box.x1; cx++) {
+				if (!CellInReach(cx, cy, x, y, r)) continue;
+				int c = cy * cols + cx;
+				uint32_t begin = cellStart[c], end = cellStart[c + 1];
+
+				// Most cells hold a handful of items; below one full batch the
+				// inline test (same math as the kernel) beats the call
+				if (end - begin < 8) {
+					for (uint32_t n = begin; n < end; n++) {
+						float dx = x - itemX[n];
+						float dy = y - itemY[n];
+						float hitR = r + itemR[n];
+						if (dx * dx + dy * dy <= hitR * hitR) visit(items[n]);
+					}
+					continue;
+				}
+
+				for (uint32_t base = begin; base < end; base += chunk) {
+					uint32_t count = std::min(chunk, end - base);
+					CircleOverlapMasks(x, y, r, &itemX[base], &itemY[base], &itemR[base], count, masks);
+
+					for (uint32_t k = 0; k < (count + 7) / 8; k++) {
+						for (uint32_t bits = masks[k]; bits; bits &= bits - 1) {
+							uint32_t lane = 0;
+							while (!(bits & (1u << lane))) lane++;
+							visit(items[base + k * 8 + lane]);
+						}
+					}
+				}
+			}
+		}
+
+		big.Overlaps(x, y, r, visit);
+		if (!outside.index.empty() && NearEdge(x, y, r))
+			outside.Overlaps(x, y, r, visit);
+	}
+};
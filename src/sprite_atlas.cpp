@@ -0,0 +1,85 @@
+#include "sprite_atlas.h"
+
+#include <algorithm>
+#include <numeric>
+
+void SpriteAtlas::Add(const std::string& name, const std::string& path) {
+	Add(name, new olc::Sprite(path));
+}
+
+void SpriteAtlas::Add(const std::string& name, olc::Sprite* source) {
+	if (!source) return;
+	if (source->width <= 0 || source->height <= 0) {
+		delete source;
+		return;
+	}
+
+	Entry e;
+	e.name = name;
+	e.source = source;
+	e.size = { source->width, source->height };
+	entries.push_back(e);
+}
+
+bool SpriteAtlas::Build() {
+	if (entries.empty()) return false;
+
+	// Shelf packing: tallest first, so each shelf wastes little height
+	std::vector<size_t> order(entries.size());
+	std::iota(order.begin(), order.end(), size_t(0));
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		return entries[a].size.y > entries[b].size.y;
+	});
+
+	int x = 0, y = 0, shelfH = 0, width = 0;
+	for (size_t i : order) {
+		Entry& e = entries[i];
+		int cellW = e.size.x + padding * 2;
+		int cellH = e.size.y + padding * 2;
+		if (x > 0 && x + cellW > maxWidth) {
+			y += shelfH;
+			x = 0;
+			shelfH = 0;
+		}
+		e.pos = { x + padding, y + padding };
+		x += cellW;
+		shelfH = std::max(shelfH, cellH);
+		width = std::max(width, x);
+	}
+	int height = y + shelfH;
+
+	sprite = new olc::Sprite(width, height);
+	std::fill(sprite->pColData.begin(), sprite->pColData.end(), olc::BLANK);
+
+	// Copy each image with its padding, clamping reads to the image's edge
+	for (Entry& e : entries) {
+		for (int py = -padding; py < e.size.y + padding; py++) {
+			int sy = std::clamp(py, 0, e.size.y - 1);
+			const olc::Pixel* src = e.source->pColData.data() + size_t(sy) * e.size.x;
+			olc::Pixel* dst = sprite->pColData.data() + size_t(e.pos.y + py) * width + e.pos.x;
+			for (int px = -padding; px < e.size.x + padding; px++)
+				dst[px] = src[std::clamp(px, 0, e.size.x - 1)];
+		}
+		delete e.source;
+		e.source = nullptr;
+	}
+
+	decal = new olc::Decal(sprite);
+	return true;
+}
+
+SpriteRegion SpriteAtlas::Find(const std::string& name) const {
+	SpriteRegion r;
+	if (!decal) return r;
+
+	for (const Entry& e : entries) {
+		if (e.name != name) continue;
+		float w = float(sprite->width), h = float(sprite->height);
+		r.decal = decal;
+		r.size = { float(e.size.x), float(e.size.y) };
+		r.uvPos = { float(e.pos.x) / w, float(e.pos.y) / h };
+		r.uvSize = { float(e.size.x) / w, float(e.size.y) / h };
+		break;
+	}
+	return r;
+}
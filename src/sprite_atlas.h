@@ -0,0 +1,43 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+#include "sprite_batch.h"
+
+#include <string>
+#include <vector>
+
+// Packs a set of images into one sprite and one decal at startup, so every
+// sprite drawn from it shares a texture and can go out in a single batch.
+// Images are placed on shelves, tallest first, each with a border of
+// 'padding' pixels copied from its own edge so filtering never pulls in a
+// neighbour. The sources are freed once packed.
+struct SpriteAtlas {
+	int padding = 2;
+	int maxWidth = 4096;
+
+	olc::Sprite* sprite = nullptr;
+	olc::Decal* decal = nullptr;
+
+	struct Entry {
+		std::string name;
+		olc::Sprite* source = nullptr;
+		olc::vi2d pos; // top-left of the image itself, inside its padding
+		olc::vi2d size;
+	};
+	std::vector<Entry> entries;
+
+	// Loads an image to be packed by the next Build. Images that fail to
+	// load are left out and Find returns an empty region for them.
+	void Add(const std::string& name, const std::string& path);
+
+	// Same, for an image already decoded elsewhere; the atlas takes it
+	void Add(const std::string& name, olc::Sprite* source);
+
+	// Places every added image and creates the atlas decal. False if
+	// nothing could be packed.
+	bool Build();
+
+	// Where 'name' ended up; empty if it was never added or failed to load
+	SpriteRegion Find(const std::string& name) const;
+
+	size_t Bytes() const { return sprite ? sprite->pColData.size() * sizeof(olc::Pixel) : 0; }
+};
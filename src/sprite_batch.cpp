@@ -0,0 +1,56 @@
+#include "sprite_batch.h"
+
+SpriteRegion SpriteRegion::Whole(olc::Decal* decal) {
+	SpriteRegion r;
+	r.decal = decal;
+	if (decal) r.size = { float(decal->sprite->width), float(decal->sprite->height) };
+	return r;
+}
+
+void SpriteBatch::Begin(olc::PixelGameEngine* target, const SpriteRegion& first, olc::DecalMode mode) {
+	pge = target;
+	toClip = { 2.0f / float(target->ScreenWidth()), 2.0f / float(target->ScreenHeight()) };
+	region = first;
+
+	task.decal = first.decal;
+	task.mode = mode;
+	task.structure = olc::DecalStructure::LIST;
+	task.vb.clear();
+}
+
+void SpriteBatch::Use(const SpriteRegion& next) {
+	if (next.decal != task.decal) {
+		End();
+		Begin(pge, next, task.mode);
+		return;
+	}
+	region = next;
+}
+
+void SpriteBatch::Add(const olc::vf2d& pos, const olc::vf2d& scale, const olc::Pixel& tint) {
+	// Clip space runs bottom-up, screen space top-down
+	float x0 = pos.x * toClip.x - 1.0f;
+	float y0 = 1.0f - pos.y * toClip.y;
+	float x1 = x0 + region.size.x * scale.x * toClip.x;
+	float y1 = y0 - region.size.y * scale.y * toClip.y;
+
+	float u0 = region.uvPos.x, v0 = region.uvPos.y;
+	float u1 = u0 + region.uvSize.x, v1 = v0 + region.uvSize.y;
+
+	size_t n = task.vb.size();
+	task.vb.resize(n + 6);
+	olc::GPUTask::Vertex* v = &task.vb[n];
+
+	// Two triangles, same corner order as DrawRotatedDecal's fan
+	//                x   y    z     w     u   v    rgb
+	v[0] = { { x0, y0, 0.0f, 1.0f, u0, v0 }, tint.n };
+	v[1] = { { x0, y1, 0.0f, 1.0f, u0, v1 }, tint.n };
+	v[2] = { { x1, y1, 0.0f, 1.0f, u1, v1 }, tint.n };
+	v[3] = v[0];
+	v[4] = v[2];
+	v[5] = { { x1, y0, 0.0f, 1.0f, u1, v0 }, tint.n };
+}
+
+void SpriteBatch::End() {
+	if (!task.vb.empty()) pge->DrawGPUTask(task);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "olcPixelGameEngine.h"
+
+// A rectangle of a decal's texture: the whole decal, or one sprite packed
+// into a SpriteAtlas. Empty (no decal) when the image failed to load.
+struct SpriteRegion {
+	olc::Decal* decal = nullptr;
+	olc::vf2d size;                    // in source pixels
+	olc::vf2d uvPos = { 0.0f, 0.0f };  // normalised texture coordinates
+	olc::vf2d uvSize = { 1.0f, 1.0f };
+
+	static SpriteRegion Whole(olc::Decal* decal);
+
+	explicit operator bool() const { return decal != nullptr; }
+};
+
+// Collects every sprite drawn from one decal into a single triangle list and
+// queues it as one GPUTask, where DrawDecal queues a DecalInstance per sprite
+// and the renderer issues a draw for each. Vertex storage is reused between
+// batches, so once it has grown to the busiest decal of a frame, filling a
+// batch allocates nothing.
+//
+// Sprites from different regions of the same decal (an atlas) share a batch:
+// Use() switches region without ending it. Only a different decal or blend
+// mode needs a new batch.
+//
+// The engine draws a layer's GPU tasks before its decals, so anything that has
+// to stay in order with batched sprites must go through a batch as well.
+struct SpriteBatch {
+	olc::GPUTask task;
+	olc::vf2d toClip = { 1.0f, 1.0f }; // pixels to clip space
+	SpriteRegion region;
+	olc::PixelGameEngine* pge = nullptr;
+
+	void Begin(olc::PixelGameEngine* target, const SpriteRegion& first, olc::DecalMode mode = olc::DecalMode::NORMAL);
+	void Begin(olc::PixelGameEngine* target, olc::Decal* decal, olc::DecalMode mode = olc::DecalMode::NORMAL) {
+		Begin(target, SpriteRegion::Whole(decal), mode);
+	}
+	// Later Adds draw 'next'. A region of another decal ends this batch and
+	// begins a new one in the same mode.
+	void Use(const SpriteRegion& next);
+	// Same placement as DrawPartialDecal(pos, region.decal, region's source rect, scale, tint)
+	void Add(const olc::vf2d& pos, const olc::vf2d& scale, const olc::Pixel& tint = olc::WHITE);
+	// Hands the batch to the engine; an empty batch is dropped
+	void End();
+
+	size_t Size() const { return task.vb.size() / 6; }
+};